@@ -0,0 +1,29 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include "charging_network.h"
+#include "simulation.h"
+using namespace std;
+
+// Fixed simulation workload used for PGO training and the perf regression gate.
+// Usage: ev_bench [iterations]
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    if (iterations < 1) iterations = 1;
+    uint64_t combined = 0;
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        ChargingNetwork network;
+        for (int s = 0; s < MAX_STATIONS; s++) network.stations[s]->dockPolicy = (DockPolicy)(i % (POLICY_CARBON_AWARE + 1));
+        DeterministicSimulator sim(network, (uint64_t)i + 1);
+        sim.run(40, 1);
+        combined ^= sim.digest() + (uint64_t)i;
+    }
+    auto end = chrono::steady_clock::now();
+    double totalUs = chrono::duration<double, micro>(end - begin).count();
+    cout << "Benchmark iterations: " << iterations << endl;
+    cout << "Benchmark digest: " << hex << combined << dec << endl;
+    cout << "Benchmark mean us: " << fixed << setprecision(3) << totalUs / iterations << endl;
+    return 0;
+}
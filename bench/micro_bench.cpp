@@ -0,0 +1,201 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "charging_station.h"
+#include "depot_optimizer.h"
+#include "meter_ingest.h"
+#include "time_series_store.h"
+using namespace std;
+
+// Timings of individual subsystems, separate from the gated ev_bench workload.
+// Usage: ev_microbench [case ...], every case when none is given
+
+// Station output goes nowhere, as in DeterministicSimulator
+static ostream quiet(nullptr);
+
+static double secondsSince(chrono::steady_clock::time_point begin) {
+    return chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+}
+
+// End-of-day settlement of 1M sessions spread over the station's docks
+static void benchSettle() {
+    const int SESSIONS = 1000000;
+    ChargingStation station;
+    station.setLog(&quiet);
+    station.registerUser(1, "Bench", 0);
+    station.registerVehicle(1, 1, 20.0f, 80.0f, false);
+    station.setBookingCapacity(SESSIONS);
+    for (int i = 0; i < SESSIONS; i++) {
+        station.placeBooking(1, 1, i % MAX_DOCKS, (i / MAX_DOCKS) * 0.1f, 0.1f, 1);
+    }
+    vector<Invoice> ledger;
+    ledger.reserve(SESSIONS);
+    auto begin = chrono::steady_clock::now();
+    int settled = station.settleBookings(SESSIONS / MAX_DOCKS * 0.1f + 1.0f, ledger, 1);
+    double seconds = secondsSince(begin);
+    cout << "settle: " << settled << " sessions in " << fixed << setprecision(3) << seconds << " s" << endl;
+}
+
+// Week calendars of 40 docks (8 stations) booked in half-hour sessions,
+// every third one left free
+static void benchCalendar() {
+    const int STATIONS = 8, REPEATS = 1000;
+    const float WEEK = 7.0f * HOURS_PER_DAY;
+    vector<ChargingStation*> stations;
+    for (int s = 0; s < STATIONS; s++) {
+        ChargingStation* station = new ChargingStation(s + 1);
+        station->setLog(&quiet);
+        station->registerUser(1, "Bench", 0);
+        station->registerVehicle(1, 1, 20.0f, 80.0f, false);
+        station->setBookingCapacity((int)(WEEK * 2) * MAX_DOCKS);
+        for (int d = 0; d < MAX_DOCKS; d++) {
+            for (int k = 0; k < (int)(WEEK * 2); k++) {
+                if ((k + d) % 3 != 0) station->placeBooking(1, 1, d, k * 0.5f, 0.5f, 1);
+            }
+        }
+        stations.push_back(station);
+    }
+    vector<CalendarInterval> out;
+    long long intervals = 0;
+    auto begin = chrono::steady_clock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        for (ChargingStation* station : stations) {
+            for (int d = 0; d < MAX_DOCKS; d++) {
+                out.clear();
+                intervals += station->getDockCalendar(d, 0.0f, WEEK, out);
+            }
+        }
+    }
+    double seconds = secondsSince(begin);
+    cout << "calendar: " << STATIONS * MAX_DOCKS << " docks over a week in " << fixed << setprecision(1)
+         << seconds * 1e6 / REPEATS << " us (" << intervals / REPEATS << " intervals)" << endl;
+    for (ChargingStation* station : stations) delete station;
+}
+
+// Overnight plan for 500 vehicles on 100 docks of mixed ratings
+static void benchDepot() {
+    const int VEHICLES = 500, DOCKS = 100;
+    const float RATINGS[3] = { (float)SLOW, (float)MEDIUM, (float)FAST };
+    vector<DepotDock> docks(DOCKS);
+    for (int d = 0; d < DOCKS; d++) {
+        docks[d].dockID = d + 1;
+        docks[d].powerKW = RATINGS[d % 3];
+    }
+    vector<DepotVehicle> vehicles(VEHICLES);
+    unsigned int seed = 12345;
+    auto next = [&seed](int range) {
+        seed = seed * 1103515245u + 12345u;
+        return (int)((seed >> 16) % (unsigned int)range);
+    };
+    for (int v = 0; v < VEHICLES; v++) {
+        DepotVehicle& dv = vehicles[v];
+        dv.vehicle.registerVehicle(v + 1, 1, 10.0f + next(50), 40.0f + next(61), false);
+        dv.arrivalTime = 17.0f + next(20) * 0.25f;
+        dv.departureTime = HOURS_PER_DAY + 5.0f + next(12) * 0.25f;
+        dv.targetSOC = 80.0f;
+    }
+    DepotOptimizer optimizer(DepotOptimizer::standardTariff(), 1500.0f);
+    auto begin = chrono::steady_clock::now();
+    DepotSchedule plan = optimizer.optimize(vehicles, docks);
+    double seconds = secondsSince(begin);
+    cout << "depot: " << VEHICLES << " vehicles on " << DOCKS << " docks in " << fixed << setprecision(1)
+         << seconds * 1e3 << " ms (" << plan.unmetVehicles << " unmet)" << endl;
+}
+
+// Meter readings at 1 s into one long session, consumed on the pushing
+// thread and then with a separate feed thread
+static void benchMeter() {
+    const long long READINGS = 20000000;
+    ChargingStation station;
+    station.setLog(&quiet);
+    station.registerUser(1, "Bench", 0);
+    station.registerVehicle(1, 1, 20.0f, 80.0f, false);
+    station.placeBooking(1, 1, 0, 0.0f, 20000.0f, 1);
+    int dockID = station.docks[0].dockID;
+
+    MeterIngestor single(station);
+    auto begin = chrono::steady_clock::now();
+    for (long long i = 0; i < READINGS; i++) {
+        MeterReading r = { dockID, i * 1000, 7.0f, -1 };
+        if (!single.push(r)) {
+            single.process();
+            single.push(r);
+        }
+    }
+    single.process();
+    double seconds = secondsSince(begin);
+    cout << "meter: " << fixed << setprecision(1) << READINGS / seconds / 1e6 << "M readings/s on one thread" << endl;
+
+    station.bookings[0].measuredWh = -1;
+    MeterIngestor fed(station);
+    long long consumed = 0;
+    begin = chrono::steady_clock::now();
+    thread feed([&fed, dockID] {
+        for (long long i = 0; i < READINGS; i++) {
+            MeterReading r = { dockID, i * 1000, 7.0f, -1 };
+            while (!fed.push(r)) this_thread::yield();
+        }
+    });
+    while (consumed < READINGS) {
+        int n = fed.process();
+        if (n == 0) this_thread::yield();
+        consumed += n;
+    }
+    feed.join();
+    seconds = secondsSince(begin);
+    cout << "meter: " << fixed << setprecision(1) << READINGS / seconds / 1e6 << "M readings/s with a feed thread" << endl;
+}
+
+// 30 days of 5 s samples of stepwise power: size, then scans by day
+// (mostly chunk summaries) and by minute (every chunk decoded)
+static void benchStore() {
+    const long long STEP_MS = 5000, DAY_MS = 24LL * 3600000, SPAN_MS = 30 * DAY_MS;
+    const int REPEATS = 20;
+    TimeSeriesStore store;
+    int s = store.seriesFor(1, 1);
+    for (long long t = 0; t < SPAN_MS; t += STEP_MS) {
+        long long minute = t / 60000;
+        store.append(s, t, (minute % 90 < 60) ? 7.0f + (float)(minute / 30 % 3) : 0.0f);
+    }
+    long long samples = store.sampleCount();
+    cout << "store: " << samples << " samples, " << fixed << setprecision(2)
+         << (double)store.compressedBytes() / samples << " bytes per sample" << endl;
+
+    const long long BUCKETS[2] = { DAY_MS, 60000 };
+    const char* NAMES[2] = { "daily", "minute" };
+    vector<SeriesBucket> out;
+    for (int b = 0; b < 2; b++) {
+        long long points = 0;
+        auto begin = chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; r++) points += store.scan(s, 0, SPAN_MS, BUCKETS[b], out);
+        double seconds = secondsSince(begin);
+        cout << "store: " << NAMES[b] << " scans at " << fixed << setprecision(0) << points / seconds / 1e6
+             << "M points/s" << endl;
+    }
+}
+
+struct BenchCase {
+    const char* name;
+    void (*run)();
+};
+
+static const BenchCase CASES[] = {
+    { "settle", benchSettle },
+    { "calendar", benchCalendar },
+    { "depot", benchDepot },
+    { "meter", benchMeter },
+    { "store", benchStore },
+};
+
+int main(int argc, char* argv[]) {
+    for (const BenchCase& c : CASES) {
+        bool selected = (argc == 1);
+        for (int i = 1; i < argc; i++) selected = selected || strcmp(argv[i], c.name) == 0;
+        if (selected) c.run();
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+# Optimization, sanitizer and profile-guided build flags for the EV charging targets
+
+include(CheckIPOSupported)
+
+function(ev_apply_build_flags target)
+    # Link-time optimization for optimized configurations
+    if(EV_ENABLE_LTO AND NOT EV_SANITIZER)
+        check_ipo_supported(RESULT ipo_supported OUTPUT ipo_output LANGUAGES CXX)
+        if(ipo_supported)
+            set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION_RELEASE ON)
+            set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION_RELWITHDEBINFO ON)
+        else()
+            message(STATUS "LTO not supported: ${ipo_output}")
+        endif()
+    endif()
+
+    # Sanitizer configurations
+    if(EV_SANITIZER)
+        target_compile_options(${target} PRIVATE -fsanitize=${EV_SANITIZER} -fno-omit-frame-pointer -g)
+        target_link_options(${target} PRIVATE -fsanitize=${EV_SANITIZER})
+    endif()
+
+    # Profile-guided optimization stages
+    if(EV_PGO STREQUAL "GENERATE")
+        target_compile_options(${target} PRIVATE -fprofile-generate=${EV_PGO_DIR})
+        target_link_options(${target} PRIVATE -fprofile-generate=${EV_PGO_DIR})
+    elseif(EV_PGO STREQUAL "USE")
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            set(pgo_use_flags -fprofile-use=${EV_PGO_DIR} -fprofile-correction -fprofile-partial-training
+                -Wno-missing-profile)
+        else()
+            set(pgo_use_flags -fprofile-use=${EV_PGO_DIR}/default.profdata)
+        endif()
+        target_compile_options(${target} PRIVATE ${pgo_use_flags})
+        target_link_options(${target} PRIVATE ${pgo_use_flags})
+    elseif(NOT EV_PGO STREQUAL "OFF")
+        message(FATAL_ERROR "EV_PGO must be OFF, GENERATE or USE (got '${EV_PGO}')")
+    endif()
+endfunction()
@@ -0,0 +1,92 @@
+# Perf regression gate: runs the ev_bench workload several times and compares the fastest run
+# with the stored baseline.
+# The run fails if the fastest run's time per iteration exceeds the baseline by more than the
+# tolerance, or if the workload digest differs (the simulated behaviour changed and the baseline
+# must be refreshed).
+#
+# Usage: cmake -DEV_BINARY=<ev_bench> -DEV_BASELINE=<baseline.txt> [-DEV_UPDATE_BASELINE=ON]
+#              -P cmake/PerfGate.cmake
+
+cmake_minimum_required(VERSION 3.16)
+
+if(NOT EV_BINARY OR NOT EV_BASELINE)
+    message(FATAL_ERROR "EV_BINARY and EV_BASELINE must be set")
+endif()
+
+set(iterations 2000)
+set(tolerance 20)
+set(repeats 5)
+set(baseline_mean "")
+set(baseline_digest "")
+if(EXISTS "${EV_BASELINE}")
+    file(STRINGS "${EV_BASELINE}" baseline_lines REGEX "^[a-z_]+=")
+    foreach(line IN LISTS baseline_lines)
+        string(REGEX MATCH "^([a-z_]+)=(.*)$" _ "${line}")
+        set(key "${CMAKE_MATCH_1}")
+        set(value "${CMAKE_MATCH_2}")
+        if(key STREQUAL "iterations")
+            set(iterations "${value}")
+        elseif(key STREQUAL "repeats")
+            set(repeats "${value}")
+        elseif(key STREQUAL "tolerance_percent")
+            set(tolerance "${value}")
+        elseif(key STREQUAL "mean_us")
+            set(baseline_mean "${value}")
+        elseif(key STREQUAL "digest")
+            set(baseline_digest "${value}")
+        endif()
+    endforeach()
+endif()
+
+# Best of several runs; the minimum is far less sensitive to machine noise than a single run
+set(best "")
+set(digest "")
+foreach(run RANGE 1 ${repeats})
+    execute_process(COMMAND "${EV_BINARY}" ${iterations}
+                    OUTPUT_VARIABLE output RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Benchmark failed (${result})")
+    endif()
+    string(REGEX MATCH "Benchmark mean us: ([0-9.]+)" _ "${output}")
+    set(run_best "${CMAKE_MATCH_1}")
+    string(REGEX MATCH "Benchmark digest: ([0-9a-f]+)" _ "${output}")
+    set(run_digest "${CMAKE_MATCH_1}")
+    if(run_best STREQUAL "" OR run_digest STREQUAL "")
+        message(FATAL_ERROR "Could not parse benchmark output:\n${output}")
+    endif()
+    if(digest STREQUAL "")
+        set(digest "${run_digest}")
+    elseif(NOT digest STREQUAL run_digest)
+        message(FATAL_ERROR "Benchmark digest differs between runs (${digest}, ${run_digest})")
+    endif()
+    string(REGEX REPLACE "\\..*$" "" run_int "${run_best}")
+    if(best STREQUAL "" OR run_int LESS best_int)
+        set(best "${run_best}")
+        set(best_int "${run_int}")
+    endif()
+endforeach()
+
+if(EV_UPDATE_BASELINE OR baseline_mean STREQUAL "")
+    file(WRITE "${EV_BASELINE}"
+        "# Perf regression gate baseline (written by cmake/PerfGate.cmake)\n"
+        "iterations=${iterations}\n"
+        "repeats=${repeats}\n"
+        "tolerance_percent=${tolerance}\n"
+        "mean_us=${best}\n"
+        "digest=${digest}\n")
+    message(STATUS "Baseline updated: ${best} us/iteration, digest ${digest}")
+    return()
+endif()
+
+if(NOT digest STREQUAL baseline_digest)
+    message(FATAL_ERROR "Benchmark digest ${digest} differs from baseline ${baseline_digest}; "
+                        "simulation behaviour changed, refresh the baseline with -DEV_UPDATE_BASELINE=ON")
+endif()
+
+# Compare whole microseconds since CMake math() has no floating point
+string(REGEX REPLACE "\\..*$" "" baseline_int "${baseline_mean}")
+math(EXPR limit "${baseline_int} * (100 + ${tolerance}) / 100")
+message(STATUS "Benchmark: best ${best} us/iteration of ${repeats} runs (baseline ${baseline_mean}, limit ${limit})")
+if(best_int GREATER limit)
+    message(FATAL_ERROR "Perf regression: ${best} us/iteration exceeds baseline ${baseline_mean} by more than ${tolerance}%")
+endif()
@@ -0,0 +1,49 @@
+# Profile-guided optimization pipeline:
+#   1. instrumented build (EV_PGO=GENERATE)
+#   2. training run of the ev_bench workload, which profiles the shared engine library
+#   3. optimized rebuild from the collected profile (EV_PGO=USE)
+#
+# Usage: cmake -P cmake/Pgo.cmake [-DEV_PGO_BUILD_DIR=_pgo_build] [-DEV_PGO_ITERATIONS=2000]
+
+cmake_minimum_required(VERSION 3.16)
+
+get_filename_component(EV_SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/.." ABSOLUTE)
+if(NOT EV_PGO_BUILD_DIR)
+    set(EV_PGO_BUILD_DIR "${EV_SOURCE_DIR}/_pgo_build")
+endif()
+if(NOT EV_PGO_ITERATIONS)
+    set(EV_PGO_ITERATIONS 2000)
+endif()
+set(profile_dir "${EV_PGO_BUILD_DIR}/profiles")
+set(gen_dir "${EV_PGO_BUILD_DIR}/generate")
+set(use_dir "${EV_PGO_BUILD_DIR}/use")
+
+function(ev_run)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Command failed (${result}): ${ARGN}")
+    endif()
+endfunction()
+
+message(STATUS "PGO: instrumented build")
+file(REMOVE_RECURSE "${profile_dir}")
+ev_run(${CMAKE_COMMAND} -S "${EV_SOURCE_DIR}" -B "${gen_dir}" -DCMAKE_BUILD_TYPE=Release
+       -DEV_PGO=GENERATE "-DEV_PGO_DIR=${profile_dir}")
+ev_run(${CMAKE_COMMAND} --build "${gen_dir}" --target ev_bench)
+
+message(STATUS "PGO: training run (${EV_PGO_ITERATIONS} iterations)")
+ev_run("${gen_dir}/ev_bench" ${EV_PGO_ITERATIONS})
+
+# Clang writes raw profiles that must be merged first
+file(GLOB raw_profiles "${profile_dir}/*.profraw")
+if(raw_profiles)
+    find_program(LLVM_PROFDATA llvm-profdata REQUIRED)
+    ev_run(${LLVM_PROFDATA} merge -o "${profile_dir}/default.profdata" ${raw_profiles})
+endif()
+
+message(STATUS "PGO: optimized rebuild")
+ev_run(${CMAKE_COMMAND} -S "${EV_SOURCE_DIR}" -B "${use_dir}" -DCMAKE_BUILD_TYPE=Release
+       -DEV_PGO=USE "-DEV_PGO_DIR=${profile_dir}")
+ev_run(${CMAKE_COMMAND} --build "${use_dir}")
+
+message(STATUS "PGO: optimized binaries in ${use_dir}")
@@ -0,0 +1,204 @@
+#include "billing_ledger.h"
+
+#include <algorithm>
+#include <thread>
+using namespace std;
+
+// Table size: power of two with at most 50% load
+static int tableSize(int capacity) {
+    int size = 16;
+    while (size < capacity * 2) size <<= 1;
+    return size;
+}
+
+static unsigned int hashKey(int userID, int month) {
+    unsigned long long k = ((unsigned long long)(unsigned int)userID << 32) | (unsigned int)month;
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    return (unsigned int)k;
+}
+
+BillingLedger::BillingLedger(int entryCapacity, int userCapacity, int rollupCapacity)
+    : entries(max(0, entryCapacity)), capacity(max(0, entryCapacity)), nextSequence(0) {
+    int balanceSize = tableSize(userCapacity);
+    int rollupSize = tableSize(rollupCapacity);
+    balanceMask = balanceSize - 1;
+    rollupMask = rollupSize - 1;
+    balances.reset(new BalanceSlot[balanceSize]);
+    rollups.reset(new RollupSlot[rollupSize]);
+    for (int i = 0; i < balanceSize; i++) {
+        balances[i].state.store(SLOT_EMPTY, memory_order_relaxed);
+        balances[i].userID = 0;
+        balances[i].balance.store(0, memory_order_relaxed);
+    }
+    for (int i = 0; i < rollupSize; i++) {
+        RollupSlot& r = rollups[i];
+        r.state.store(SLOT_EMPTY, memory_order_relaxed);
+        r.userID = 0;
+        r.month = 0;
+        r.account = nullptr;
+        r.sessions.store(0, memory_order_relaxed);
+        r.charges.store(0, memory_order_relaxed);
+        r.penalties.store(0, memory_order_relaxed);
+        r.payments.store(0, memory_order_relaxed);
+    }
+    for (int a = 0; a < ACCOUNT_COUNT; a++) {
+        debits[a].store(0, memory_order_relaxed);
+        credits[a].store(0, memory_order_relaxed);
+    }
+}
+
+BillingLedger::BalanceSlot* BillingLedger::findBalance(int userID, bool create) {
+    for (int probe = 0, i = hashKey(userID, 0) & balanceMask; probe <= balanceMask; probe++, i = (i + 1) & balanceMask) {
+        BalanceSlot& slot = balances[i];
+        int state = slot.state.load(memory_order_acquire);
+        if (state == SLOT_EMPTY) {
+            if (!create) return nullptr;
+            int expected = SLOT_EMPTY;
+            if (slot.state.compare_exchange_strong(expected, SLOT_CLAIMING, memory_order_acq_rel)) {
+                slot.userID = userID;
+                slot.state.store(SLOT_READY, memory_order_release);
+                return &slot;
+            }
+            state = expected;
+        }
+        // Another thread is publishing this slot; its key appears momentarily
+        while (state == SLOT_CLAIMING) state = slot.state.load(memory_order_acquire);
+        if (slot.userID == userID) return &slot;
+    }
+    return nullptr;
+}
+
+const BillingLedger::BalanceSlot* BillingLedger::findBalance(int userID) const {
+    return const_cast<BillingLedger*>(this)->findBalance(userID, false);
+}
+
+BillingLedger::RollupSlot* BillingLedger::findRollup(int userID, int month, BalanceSlot* account) {
+    for (int probe = 0, i = hashKey(userID, month) & rollupMask; probe <= rollupMask; probe++, i = (i + 1) & rollupMask) {
+        RollupSlot& slot = rollups[i];
+        int state = slot.state.load(memory_order_acquire);
+        if (state == SLOT_EMPTY) {
+            int expected = SLOT_EMPTY;
+            if (slot.state.compare_exchange_strong(expected, SLOT_CLAIMING, memory_order_acq_rel)) {
+                slot.userID = userID;
+                slot.month = month;
+                slot.account = account;
+                slot.state.store(SLOT_READY, memory_order_release);
+                return &slot;
+            }
+            state = expected;
+        }
+        while (state == SLOT_CLAIMING) state = slot.state.load(memory_order_acquire);
+        if (slot.userID == userID && slot.month == month) return &slot;
+    }
+    return nullptr;
+}
+
+long long BillingLedger::append(int type, int stationID, int userID, int bookingID, int month,
+                                int debitAccount, int creditAccount, Millicents amount) {
+    BalanceSlot* account = findBalance(userID, true);
+    if (account == nullptr) return -1;
+    RollupSlot* rollup = findRollup(userID, month, account);
+    if (rollup == nullptr) return -1;
+    long long sequence = nextSequence.fetch_add(1, memory_order_relaxed);
+    if (sequence >= capacity) return -1;
+
+    LedgerEntry& e = entries[sequence];
+    e.sequence = sequence;
+    e.type = type;
+    e.stationID = stationID;
+    e.userID = userID;
+    e.bookingID = bookingID;
+    e.month = month;
+    e.debitAccount = debitAccount;
+    e.creditAccount = creditAccount;
+    e.amount = amount;
+
+    debits[debitAccount].fetch_add(amount, memory_order_relaxed);
+    credits[creditAccount].fetch_add(amount, memory_order_relaxed);
+    if (type == ENTRY_PAYMENT) {
+        account->balance.fetch_sub(amount, memory_order_relaxed);
+        rollup->payments.fetch_add(amount, memory_order_relaxed);
+    } else {
+        account->balance.fetch_add(amount, memory_order_relaxed);
+        if (type == ENTRY_CHARGE) {
+            rollup->charges.fetch_add(amount, memory_order_relaxed);
+            rollup->sessions.fetch_add(1, memory_order_relaxed);
+        } else {
+            rollup->penalties.fetch_add(amount, memory_order_relaxed);
+        }
+    }
+    return sequence;
+}
+
+long long BillingLedger::postCharge(int stationID, int userID, int bookingID, Millicents amount, int month) {
+    return append(ENTRY_CHARGE, stationID, userID, bookingID, month, ACCOUNT_RECEIVABLE, ACCOUNT_CHARGING_REVENUE, amount);
+}
+
+long long BillingLedger::postPenalty(int stationID, int userID, int bookingID, Millicents amount, int month) {
+    return append(ENTRY_PENALTY, stationID, userID, bookingID, month, ACCOUNT_RECEIVABLE, ACCOUNT_PENALTY_REVENUE, amount);
+}
+
+long long BillingLedger::postPayment(int userID, Millicents amount, int month) {
+    return append(ENTRY_PAYMENT, -1, userID, -1, month, ACCOUNT_CASH, ACCOUNT_RECEIVABLE, amount);
+}
+
+Millicents BillingLedger::balance(int userID) const {
+    const BalanceSlot* slot = findBalance(userID);
+    return (slot == nullptr) ? 0 : slot->balance.load(memory_order_relaxed);
+}
+
+bool BillingLedger::isBalanced() const {
+    Millicents totalDebits = 0, totalCredits = 0;
+    for (int a = 0; a < ACCOUNT_COUNT; a++) {
+        if (!addChecked(totalDebits, accountDebits(a)) || !addChecked(totalCredits, accountCredits(a))) return false;
+    }
+    return totalDebits == totalCredits;
+}
+
+long long BillingLedger::size() const {
+    return min(nextSequence.load(memory_order_acquire), capacity);
+}
+
+vector<MonthlyStatement> BillingLedger::generateStatements(int month, int threadCount) const {
+    int slots = rollupMask + 1;
+    if (threadCount < 1) threadCount = 1;
+    vector<vector<MonthlyStatement>> parts(threadCount);
+    auto collect = [this, month, slots, threadCount, &parts](int t) {
+        int begin = (int)((long long)slots * t / threadCount);
+        int end = (int)((long long)slots * (t + 1) / threadCount);
+        vector<MonthlyStatement>& out = parts[t];
+        for (int i = begin; i < end; i++) {
+            const RollupSlot& r = rollups[i];
+            if (r.state.load(memory_order_acquire) != SLOT_READY || r.month != month) continue;
+            MonthlyStatement s;
+            s.userID = r.userID;
+            s.month = month;
+            s.sessions = r.sessions.load(memory_order_relaxed);
+            s.charges = r.charges.load(memory_order_relaxed);
+            s.penalties = r.penalties.load(memory_order_relaxed);
+            s.payments = r.payments.load(memory_order_relaxed);
+            s.balance = r.account->balance.load(memory_order_relaxed);
+            out.push_back(s);
+        }
+        sort(out.begin(), out.end(), [](const MonthlyStatement& a, const MonthlyStatement& b) { return a.userID < b.userID; });
+    };
+    if (threadCount == 1) {
+        collect(0);
+    } else {
+        vector<thread> workers;
+        for (int t = 0; t < threadCount; t++) workers.emplace_back(collect, t);
+        for (thread& w : workers) w.join();
+    }
+
+    // Merge the sorted parts
+    vector<MonthlyStatement> statements;
+    for (vector<MonthlyStatement>& part : parts) {
+        size_t middle = statements.size();
+        statements.insert(statements.end(), part.begin(), part.end());
+        inplace_merge(statements.begin(), statements.begin() + middle, statements.end(),
+            [](const MonthlyStatement& a, const MonthlyStatement& b) { return a.userID < b.userID; });
+    }
+    return statements;
+}
@@ -0,0 +1,110 @@
+#ifndef BILLING_LEDGER_H
+#define BILLING_LEDGER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "money.h"
+
+// Ledger accounts. Every entry debits one account and credits another by the
+// same amount, so total debits always equal total credits.
+enum LedgerAccount { ACCOUNT_RECEIVABLE, ACCOUNT_CASH, ACCOUNT_CHARGING_REVENUE, ACCOUNT_PENALTY_REVENUE, ACCOUNT_COUNT };
+
+enum LedgerEntryType { ENTRY_CHARGE, ENTRY_PENALTY, ENTRY_PAYMENT };
+
+struct LedgerEntry {
+    long long sequence;
+    int type;          // LedgerEntryType
+    int stationID;
+    int userID;
+    int bookingID;
+    int month;         // billing period, e.g. 202610
+    int debitAccount;
+    int creditAccount;
+    Millicents amount;
+};
+
+// Per-user totals for one billing period
+struct MonthlyStatement {
+    int userID;
+    int month;
+    int sessions;
+    Millicents charges;
+    Millicents penalties;
+    Millicents payments;
+    Millicents balance;  // running balance at generation time
+};
+
+// Append-only double-entry billing ledger shared by all stations.
+// Appends are lock-free: a slot is claimed with one atomic increment and the
+// user balance and monthly rollup are updated with atomic adds, so station
+// shards can post concurrently. Balances and rollups live in fixed-capacity
+// open-addressing tables, giving O(1) balance queries.
+class BillingLedger {
+public:
+    // Tables are sized for the given number of users and (user, month) rollups
+    BillingLedger(int entryCapacity, int userCapacity, int rollupCapacity);
+
+    // Disable copy constructor and assignment operator; the ledger owns atomics
+    BillingLedger(const BillingLedger&) = delete;
+    BillingLedger& operator=(const BillingLedger&) = delete;
+
+    // Each returns the entry sequence number, or -1 if the ledger or one of its tables is full
+    long long postCharge(int stationID, int userID, int bookingID, Millicents amount, int month);
+    long long postPenalty(int stationID, int userID, int bookingID, Millicents amount, int month);
+    long long postPayment(int userID, Millicents amount, int month);
+
+    // Amount owed by the user (charges and penalties less payments)
+    Millicents balance(int userID) const;
+
+    Millicents accountDebits(int account) const { return debits[account].load(std::memory_order_relaxed); }
+    Millicents accountCredits(int account) const { return credits[account].load(std::memory_order_relaxed); }
+    bool isBalanced() const;
+
+    // Number of appended entries; read entries only after the posting threads have finished
+    long long size() const;
+    const LedgerEntry& entry(long long sequence) const { return entries[sequence]; }
+
+    // Statements for every user with activity in the month, sorted by user ID
+    std::vector<MonthlyStatement> generateStatements(int month, int threadCount = 1) const;
+
+private:
+    enum SlotState { SLOT_EMPTY, SLOT_CLAIMING, SLOT_READY };
+
+    struct BalanceSlot {
+        std::atomic<int> state;
+        int userID;
+        std::atomic<long long> balance;
+    };
+
+    struct RollupSlot {
+        std::atomic<int> state;
+        int userID;
+        int month;
+        BalanceSlot* account; // the user's balance, so statements skip a lookup
+        std::atomic<int> sessions;
+        std::atomic<long long> charges;
+        std::atomic<long long> penalties;
+        std::atomic<long long> payments;
+    };
+
+    long long append(int type, int stationID, int userID, int bookingID, int month,
+                     int debitAccount, int creditAccount, Millicents amount);
+    BalanceSlot* findBalance(int userID, bool create);
+    const BalanceSlot* findBalance(int userID) const;
+    RollupSlot* findRollup(int userID, int month, BalanceSlot* account);
+
+    std::vector<LedgerEntry> entries;
+    long long capacity;
+    std::atomic<long long> nextSequence;
+
+    std::unique_ptr<BalanceSlot[]> balances;
+    std::unique_ptr<RollupSlot[]> rollups;
+    int balanceMask;
+    int rollupMask;
+
+    std::atomic<long long> debits[ACCOUNT_COUNT];
+    std::atomic<long long> credits[ACCOUNT_COUNT];
+};
+
+#endif // BILLING_LEDGER_H
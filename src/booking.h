@@ -0,0 +1,123 @@
+#ifndef BOOKING_H
+#define BOOKING_H
+
+#include "money.h"
+
+// Structure for queued bookings
+struct QueuedBooking {
+    int userID;
+    int vehicleID;
+    float startTime;
+    float duration;
+    int powerRating;
+    int chargingType;
+    QueuedBooking(int uID, int vID, float sTime, float dur, int pRating, int cType)
+        : userID(uID), vehicleID(vID), startTime(sTime), duration(dur), powerRating(pRating), chargingType(cType) {}
+};
+
+// Booking class
+class Booking {
+public:
+    int bookingID;
+    int userID;
+    int vehicleID;
+    int dockID;
+    int dockSlot; // index into ChargingStation::docks
+    int stationID;
+    float startTime;
+    float duration;
+    bool isActive;
+    Millicents costMillicents;
+    WattHours energyWh;
+    int chargingType;
+    int ruleID; // RecurringRule this occurrence belongs to, 0 for one-off bookings
+    bool isHeld; // reserved but not yet confirmed; isActive is set on confirmation
+    long long holdExpiry; // seconds, while isHeld
+    bool isExpired; // hold that expired or was released without confirmation
+    bool isCompleted; // session ran to its end and was billed
+    float gridKW; // power granted by the station's power tree, -1 if unlimited
+    bool gridLoaded; // gridKW is currently recorded on the tree
+    float phaseKW; // draw recorded on the station's phase buckets while balancing
+    WattHours measuredWh; // energy integrated from meter readings, -1 if none
+
+    Booking() : bookingID(-1), userID(-1), vehicleID(-1), dockID(-1), dockSlot(-1), stationID(-1), startTime(0.0f),
+                duration(0.0f), isActive(false), costMillicents(0), energyWh(0), chargingType(0), ruleID(0),
+                isHeld(false), holdExpiry(0), isExpired(false), isCompleted(false), gridKW(-1.0f), gridLoaded(false),
+                phaseKW(0.0f), measuredWh(-1) {}
+
+    void createBooking(int bID, int uID, int vID, int dID, int dSlot, int sID, float time, float dur, int type) {
+        bookingID = bID;
+        userID = uID;
+        vehicleID = vID;
+        dockID = dID;
+        dockSlot = dSlot;
+        stationID = sID;
+        startTime = time;
+        duration = dur;
+        isActive = true;
+        costMillicents = 0;
+        energyWh = 0;
+        chargingType = type;
+        ruleID = 0;
+        isHeld = false;
+        holdExpiry = 0;
+        isExpired = false;
+        isCompleted = false;
+        gridKW = -1.0f;
+        gridLoaded = false;
+        phaseKW = 0.0f;
+        measuredWh = -1;
+    }
+
+    void cancelBooking() {
+        isActive = false;
+    }
+
+    void completeBooking() {
+        isActive = false;
+        isCompleted = true;
+    }
+
+    void expireHold() {
+        isHeld = false;
+        isExpired = true;
+    }
+
+    // Completed or cancelled session, as opposed to an open or lapsed hold
+    bool isFinished() const {
+        return !isActive && !isHeld && !isExpired;
+    }
+};
+
+// Outcome of a booking request in a batch
+enum BookingStatus { BOOKING_OK, BOOKING_INVALID, BOOKING_UNKNOWN_USER, BOOKING_NO_DOCK, BOOKING_LIMIT_REACHED };
+
+// Booking request submitted through ChargingStation::createBookings
+struct BookingRequest {
+    int userID;
+    int vehicleID;
+    float startTime;
+    float duration;
+    int powerRating;
+    int chargingType;
+};
+
+struct BookingResult {
+    int status;       // BookingStatus
+    int bookingID;
+    int dockID;
+    float startTime;  // after peak-hour deferral
+};
+
+// Priced charging session, as printed on the invoice and recorded by settlement
+struct Invoice {
+    int bookingID;
+    int userID;
+    int vehicleID;
+    int dockID;
+    WattHours energyWh;
+    Millicents rateMillicentsPerKWh;
+    Millicents costMillicents;
+};
+
+#endif // BOOKING_H
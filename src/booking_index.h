@@ -0,0 +1,95 @@
+#ifndef BOOKING_INDEX_H
+#define BOOKING_INDEX_H
+
+#include <algorithm>
+#include <vector>
+
+struct IndexEntry {
+    float start;
+    float end;
+    int bookingIndex; // index into ChargingStation::bookings
+};
+
+// Start-time ordered index over bookings, built as one sorted run with fence
+// pointers plus a small sorted buffer for out-of-order arrivals. In-order
+// appends are O(1); the buffer is merged into the run once it fills up.
+// Range queries cost O(log n + k).
+class BookingTimeIndex {
+public:
+    static const int FENCE_STRIDE = 64;  // entries per fence block
+    static const int MAX_DELTA = 256;    // out-of-order entries held before a merge
+
+    BookingTimeIndex() : maxDuration(0.0f) {}
+
+    void insert(float start, float end, int bookingIndex) {
+        IndexEntry e = { start, end, bookingIndex };
+        if (end - start > maxDuration) maxDuration = end - start;
+        if (run.empty() || start >= run.back().start) {
+            if (run.size() % FENCE_STRIDE == 0) fences.push_back(start);
+            run.push_back(e);
+            return;
+        }
+        delta.insert(std::upper_bound(delta.begin(), delta.end(), e, startBefore), e);
+        if ((int)delta.size() >= MAX_DELTA) mergeDelta();
+    }
+
+    void clear() {
+        run.clear();
+        fences.clear();
+        delta.clear();
+        maxDuration = 0.0f;
+    }
+
+    int size() const { return (int)(run.size() + delta.size()); }
+
+    // Calls fn(entry) for every entry with from <= start < to, in start-time order
+    template <typename Fn>
+    void forEachStarting(float from, float to, Fn fn) const {
+        size_t i = runLowerBound(from);
+        size_t j = std::lower_bound(delta.begin(), delta.end(), from,
+            [](const IndexEntry& e, float t) { return e.start < t; }) - delta.begin();
+        while (true) {
+            bool runOk = i < run.size() && run[i].start < to;
+            bool deltaOk = j < delta.size() && delta[j].start < to;
+            if (!runOk && !deltaOk) break;
+            if (runOk && (!deltaOk || run[i].start <= delta[j].start)) fn(run[i++]);
+            else fn(delta[j++]);
+        }
+    }
+
+    // Calls fn(entry) for every entry whose [start, end) overlaps [from, to)
+    template <typename Fn>
+    void forEachOverlapping(float from, float to, Fn fn) const {
+        forEachStarting(from - maxDuration, to, [from, &fn](const IndexEntry& e) {
+            if (e.end > from) fn(e);
+        });
+    }
+
+private:
+    static bool startBefore(const IndexEntry& a, const IndexEntry& b) { return a.start < b.start; }
+
+    // First run position with start >= t: binary search over the fences, then within one block
+    size_t runLowerBound(float t) const {
+        size_t block = std::lower_bound(fences.begin(), fences.end(), t) - fences.begin();
+        size_t begin = (block == 0) ? 0 : (block - 1) * FENCE_STRIDE;
+        size_t end = std::min(run.size(), block * FENCE_STRIDE + 1);
+        return std::lower_bound(run.begin() + begin, run.begin() + end, t,
+            [](const IndexEntry& e, float v) { return e.start < v; }) - run.begin();
+    }
+
+    void mergeDelta() {
+        std::vector<IndexEntry> merged(run.size() + delta.size());
+        std::merge(run.begin(), run.end(), delta.begin(), delta.end(), merged.begin(), startBefore);
+        run.swap(merged);
+        delta.clear();
+        fences.clear();
+        for (size_t i = 0; i < run.size(); i += FENCE_STRIDE) fences.push_back(run[i].start);
+    }
+
+    std::vector<IndexEntry> run;    // sorted by start
+    std::vector<float> fences;      // run[k * FENCE_STRIDE].start
+    std::vector<IndexEntry> delta;  // sorted out-of-order arrivals
+    float maxDuration;
+};
+
+#endif // BOOKING_INDEX_H
@@ -0,0 +1,133 @@
+#include "booking_transaction.h"
+
+#include <algorithm>
+
+using namespace std;
+
+float BookingTransaction::earliestStart(ChargingStation& station, int slot, float from, float duration) const {
+    float start = from;
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        start = station.schedules[slot].earliestFree(start, duration);
+        for (const TransactionBooking& b : items) {
+            if (b.station == &station && b.slot == slot &&
+                b.startTime < start + duration && b.startTime + b.duration > start) {
+                start = b.startTime + b.duration;
+                moved = true;
+            }
+        }
+    }
+    return start;
+}
+
+void BookingTransaction::applyStagedLoad(float sign, size_t count) const {
+    for (size_t k = 0; k < count; k++) {
+        const TransactionBooking& b = items[k];
+        if (b.station->powerTree == nullptr) continue;
+        b.station->powerTree->addLoad(b.station->powerNode, b.startTime, b.startTime + b.duration, sign * b.drawKW);
+    }
+}
+
+bool BookingTransaction::stage(ChargingStation& station, const TransactionRequest& request) {
+    if (committed || request.duration <= 0.0f || request.windowEnd - request.windowStart < request.duration) return false;
+    int vehicle = (station.findUserIndex(request.userID) == -1) ? -1
+                  : station.findVehicleIndex(request.vehicleID, request.userID);
+    if (vehicle == -1) return false;
+
+    // Earliest window wins; on a tie, a dock not oversized for the vehicle
+    unsigned int preferred;
+    unsigned int compatible = station.compatibleDocks(vehicle, request.powerRating, preferred);
+    bool isSolarCharging = (request.chargingType == 4);
+    int neededKW = max(request.powerRating, ChargingStation::powerRatingFor(request.chargingType));
+    int bestSlot = -1;
+    float bestStart = 0.0f;
+    applyStagedLoad(1.0f, items.size());
+    for (int i = 0; i < MAX_DOCKS; i++) {
+        const ChargingDock& dock = station.docks[i];
+        if (dock.energySource == nullptr || !(compatible & (1u << i))) continue;
+        bool isSolar = dynamic_cast<SolarPower*>(dock.energySource) != nullptr;
+        if (dock.energySource->getAvailablePower(dock.powerRating) < request.powerRating || (isSolarCharging && !isSolar)) {
+            continue;
+        }
+        float start = earliestStart(station, i, request.windowStart, request.duration);
+        if (start + request.duration > request.windowEnd) continue;
+        if (station.powerHeadroom(start, start + request.duration) < neededKW) continue;
+        bool isPreferred = (preferred & (1u << i)) != 0;
+        if (bestSlot == -1 || start < bestStart || (start == bestStart && isPreferred && !(preferred & (1u << bestSlot)))) {
+            bestSlot = i;
+            bestStart = start;
+        }
+    }
+    applyStagedLoad(-1.0f, items.size());
+    if (bestSlot == -1) return false;
+
+    TransactionBooking b;
+    b.station = &station;
+    b.slot = bestSlot;
+    b.version = station.schedules[bestSlot].version;
+    b.userID = request.userID;
+    b.vehicleID = request.vehicleID;
+    b.startTime = bestStart;
+    b.duration = request.duration;
+    b.chargingType = request.chargingType;
+    b.drawKW = station.effectivePower(bestSlot, vehicle);
+    b.bookingID = -1;
+    items.push_back(b);
+    return true;
+}
+
+bool BookingTransaction::stage(ChargingNetwork& network, const TransactionRequest& request) {
+    for (int s = 0; s < MAX_STATIONS; s++) {
+        if (stage(*network.stations[s], request)) return true;
+    }
+    return false;
+}
+
+bool BookingTransaction::commit() {
+    if (committed) return false;
+
+    // Validate everything before placing anything
+    for (const TransactionBooking& b : items) {
+        const DockSchedule& schedule = b.station->schedules[b.slot];
+        if (schedule.version != b.version && !schedule.isFree(b.startTime, b.startTime + b.duration)) {
+            rollback();
+            return false;
+        }
+        int needed = 0;
+        for (const TransactionBooking& other : items) {
+            if (other.station == b.station) needed++;
+        }
+        if (b.station->bookingCount + needed > b.station->bookingCapacity) {
+            rollback();
+            return false;
+        }
+    }
+    // Each booking must still fit with the ones before it drawing their most,
+    // so placeBooking cannot refuse any of them for power
+    size_t loaded = 0;
+    for (; loaded < items.size(); loaded++) {
+        const TransactionBooking& b = items[loaded];
+        float end = b.startTime + b.duration;
+        if (b.station->powerHeadroom(b.startTime, end) < ChargingStation::powerRatingFor(b.chargingType)) break;
+        if (b.station->powerTree != nullptr) b.station->powerTree->addLoad(b.station->powerNode, b.startTime, end, b.drawKW);
+    }
+    applyStagedLoad(-1.0f, loaded);
+    if (loaded < items.size()) {
+        rollback();
+        return false;
+    }
+
+    for (TransactionBooking& b : items) {
+        int index = b.station->placeBooking(b.userID, b.vehicleID, b.slot, b.startTime, b.duration, b.chargingType);
+        b.bookingID = b.station->bookings[index].bookingID;
+        b.station->notifyUser(b.userID, "Upcoming charging session scheduled at:", b.startTime);
+    }
+    committed = true;
+    return true;
+}
+
+void BookingTransaction::rollback() {
+    items.clear();
+    committed = false;
+}
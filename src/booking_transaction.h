@@ -0,0 +1,72 @@
+#ifndef BOOKING_TRANSACTION_H
+#define BOOKING_TRANSACTION_H
+
+#include <vector>
+#include "charging_network.h"
+
+// Booking wanted anywhere inside a time window, e.g. overnight from 22.0 to 30.0
+struct TransactionRequest {
+    int userID;
+    int vehicleID;
+    float windowStart;
+    float windowEnd;
+    float duration;
+    int powerRating;
+    int chargingType;
+};
+
+// Booking staged in a transaction, and its booking ID once committed
+struct TransactionBooking {
+    ChargingStation* station;
+    int slot;
+    unsigned long long version; // dock schedule version when staged
+    int userID;
+    int vehicleID;
+    float startTime;
+    float duration;
+    int chargingType;
+    float drawKW; // most the booking can draw from the power tree
+    int bookingID;
+};
+
+// All-or-nothing group of bookings, on one station or across a network.
+// Staging finds a free dock window but reserves nothing, so no lock is held
+// and other bookings proceed while the transaction is open. Commit checks the
+// schedule version of every dock it staged on; a dock that changed is
+// rechecked for its staged interval, and the power tree headroom is rechecked
+// with the other staged bookings' draw counted. Either every booking is
+// placed or, on any conflict, none is and the transaction is rolled back.
+class BookingTransaction {
+public:
+    BookingTransaction() : committed(false) {}
+
+    // Stage at the earliest window on any suitable dock of the station.
+    // Returns false and stages nothing if no window fits.
+    bool stage(ChargingStation& station, const TransactionRequest& request);
+
+    // Stage at the first station of the network with a window
+    bool stage(ChargingNetwork& network, const TransactionRequest& request);
+
+    // Once committed, the transaction only reports its bookings; rollback
+    // clears it for reuse without cancelling them
+    bool commit();
+
+    void rollback();
+
+    int size() const { return (int)items.size(); }
+    const TransactionBooking& booking(int i) const { return items[i]; }
+
+private:
+    // Earliest start on a dock at or after from that avoids its schedule and
+    // this transaction's other bookings
+    float earliestStart(ChargingStation& station, int slot, float from, float duration) const;
+
+    // Add (sign 1) or remove (sign -1) the first count staged bookings' draw
+    // on their stations' power trees, so headroom queries see the transaction
+    void applyStagedLoad(float sign, size_t count) const;
+
+    std::vector<TransactionBooking> items;
+    bool committed;
+};
+
+#endif // BOOKING_TRANSACTION_H
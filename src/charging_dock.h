@@ -0,0 +1,45 @@
+#ifndef CHARGING_DOCK_H
+#define CHARGING_DOCK_H
+
+#include "constants.h"
+#include "energy_source.h"
+
+// Charging Dock class
+class ChargingDock {
+public:
+    int dockID;
+    int powerRating;
+    bool isOccupied;
+    int currentVehicleID;
+    EnergySource* energySource;
+    bool isDC;                  // FAST docks are DC, the others AC
+    unsigned int connectorMask; // CONNECTOR_* outlets
+    int cabinet;                // shared power cabinet index, -1 if standalone
+    float allocatedKW;          // cabinet power assigned while occupied
+    unsigned int phaseMask;     // PHASE_* lines the dock draws from, evenly
+
+    ChargingDock() : dockID(-1), powerRating(SLOW), isOccupied(false), currentVehicleID(-1), energySource(nullptr),
+                     isDC(false), connectorMask(CONNECTOR_TYPE2), cabinet(-1), allocatedKW(0.0f), phaseMask(ALL_PHASES) {}
+
+    // Disable copy constructor and assignment operator to avoid shallow copy
+    ChargingDock(const ChargingDock&) = delete;
+    ChargingDock& operator=(const ChargingDock&) = delete;
+
+    ~ChargingDock() { delete energySource; }
+
+    void initialize(int id, int rating, EnergySource* source) {
+        dockID = id;
+        powerRating = rating;
+        isOccupied = false;
+        currentVehicleID = -1;
+        delete energySource; // release previous if any
+        energySource = source;
+        isDC = (rating >= FAST);
+        connectorMask = isDC ? (CONNECTOR_CCS | CONNECTOR_CHADEMO) : CONNECTOR_TYPE2;
+        cabinet = -1;
+        allocatedKW = 0.0f;
+        phaseMask = ALL_PHASES;
+    }
+};
+
+#endif // CHARGING_DOCK_H
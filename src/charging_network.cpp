@@ -0,0 +1,38 @@
+#include "charging_network.h"
+
+#include <iostream>
+using namespace std;
+
+ChargingNetwork::ChargingNetwork() {
+    for (int i = 0; i < MAX_STATIONS; i++) {
+        stations[i] = new ChargingStation(i + 1);
+    }
+}
+
+ChargingNetwork::~ChargingNetwork() {
+    for (int i = 0; i < MAX_STATIONS; i++) {
+        delete stations[i];
+    }
+}
+
+ChargingStation& ChargingNetwork::getStation(int stationID) {
+    if (stationID < 1 || stationID > MAX_STATIONS) {
+        cout << "Invalid station ID! Defaulting to Station 1.\n";
+        return *stations[0];
+    }
+    return *stations[stationID - 1];
+}
+
+int ChargingNetwork::addSite(int stationID, int parent, float capacityKW) {
+    if (stationID < 1 || stationID > MAX_STATIONS) {
+        cout << "Invalid station ID!\n";
+        return -1;
+    }
+    int node = powerTree.addNode(parent, capacityKW);
+    if (node == -1) {
+        cout << "Invalid parent power node!\n";
+        return -1;
+    }
+    stations[stationID - 1]->attachPowerTree(&powerTree, node);
+    return node;
+}
@@ -0,0 +1,25 @@
+#ifndef CHARGING_NETWORK_H
+#define CHARGING_NETWORK_H
+
+#include "charging_station.h"
+#include "power_tree.h"
+
+// Charging Network class
+class ChargingNetwork {
+public:
+    ChargingStation* stations[MAX_STATIONS];
+    PowerConstraintTree powerTree; // feeders, substations and station sites
+
+    ChargingNetwork();
+
+    ~ChargingNetwork();
+
+    ChargingStation& getStation(int stationID);
+
+    // Add a site node for the station under parent (-1 for none, or a feeder
+    // added with powerTree.addNode) and attach the station to it. Returns the
+    // node ID, or -1.
+    int addSite(int stationID, int parent, float capacityKW = GRID_CAPACITY);
+};
+
+#endif // CHARGING_NETWORK_H
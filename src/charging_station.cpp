@@ -0,0 +1,1512 @@
+#include "charging_station.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <thread>
+#include <vector>
+using namespace std;
+
+ChargingStation::ChargingStation(int sID) : bookings(MAX_BOOKINGS), userCount(0), vehicleCount(0), bookingCount(0),
+    bookingCapacity(MAX_BOOKINGS), systemStartTime(0.0f), stationID(sID), log(&cout), dockPolicy(POLICY_DEFAULT),
+    billing(nullptr), billingMonth(0), recurringHorizon(7.0f * HOURS_PER_DAY), idempotency(nullptr),
+    powerTree(nullptr), powerNode(-1), preemptionEnabled(false), fairShareEnabled(false), phaseLimitKW(0.0f), phaseBalancing(false) {
+    for (int p = 0; p < PHASES; p++) phaseLoad[p] = 0.0f;
+    for (int c = 0; c < CONNECTOR_TYPES; c++) connectorDocks[c] = 0;
+    dcDocks = 0;
+    cabinetCount = 0;
+    for (int i = 0; i < MAX_DOCKS; i++) {
+        totalOccupiedTime[i] = 0.0f;
+        scheduledTime[i] = 0.0f;
+        completedSessions[i] = 0;
+    }
+    for (int i = 0; i <= MAX_DOCK_ID; i++) dockSlotByID[i] = -1;
+    initializeDock(0, 1, SLOW, new GridPower());
+    initializeDock(1, 2, SLOW, new SolarPower());
+    initializeDock(2, 3, MEDIUM, new GridPower());
+    initializeDock(3, 4, MEDIUM, new SolarPower());
+    initializeDock(4, 5, FAST, new GridPower());
+}
+
+void ChargingStation::initializeDock(int slot, int id, int rating, EnergySource* source) {
+    if (slot < 0 || slot >= MAX_DOCKS || id < 1 || id > MAX_DOCK_ID) {
+        *log << "Invalid dock slot or ID!" << endl;
+        delete source;
+        return;
+    }
+    if (docks[slot].dockID >= 1 && docks[slot].dockID <= MAX_DOCK_ID) dockSlotByID[docks[slot].dockID] = -1;
+    unsigned int bit = 1u << slot;
+    int cabinet = docks[slot].cabinet;
+    unsigned int affected = (cabinet == -1) ? bit : cabinets[cabinet].connectors;
+    applyPhaseDraw(affected, -1.0f);
+    for (const ScheduleEntry& e : schedules[slot].entries) removePhaseLoad(e.bookingIndex);
+    docks[slot].initialize(id, rating, source);
+    docks[slot].phaseMask = (rating > SLOW) ? ALL_PHASES : 1u << (slot % PHASES);
+    if (cabinet != -1) {
+        cabinets[cabinet].connectors &= ~bit;
+        cabinets[cabinet].rebalance(docks);
+    }
+    applyPhaseDraw(affected, 1.0f);
+    for (const ScheduleEntry& e : schedules[slot].entries) addPhaseLoad(e.bookingIndex);
+    dockSlotByID[id] = slot;
+
+    for (int c = 0; c < CONNECTOR_TYPES; c++) {
+        if (docks[slot].connectorMask & (1u << c)) connectorDocks[c] |= bit;
+        else connectorDocks[c] &= ~bit;
+    }
+    if (docks[slot].isDC) dcDocks |= bit;
+    else dcDocks &= ~bit;
+}
+
+int ChargingStation::addCabinet(float powerKW, const int* dockIDs, int count) {
+    if (cabinetCount >= MAX_DOCKS || powerKW <= 0.0f || count < 1) {
+        *log << "Invalid cabinet!" << endl;
+        return -1;
+    }
+    unsigned int connectors = 0;
+    for (int k = 0; k < count; k++) {
+        int slot = dockSlot(dockIDs[k]);
+        if (slot == -1 || docks[slot].cabinet != -1) {
+            *log << "Dock " << dockIDs[k] << " not found or already in a cabinet!" << endl;
+            return -1;
+        }
+        connectors |= 1u << slot;
+    }
+    PowerCabinet& c = cabinets[cabinetCount];
+    c.powerKW = powerKW;
+    c.connectors = connectors;
+    applyPhaseDraw(connectors, -1.0f);
+    for (unsigned int rest = connectors; rest != 0; rest &= rest - 1) docks[__builtin_ctz(rest)].cabinet = cabinetCount;
+    c.rebalance(docks);
+    applyPhaseDraw(connectors, 1.0f);
+    return cabinetCount++;
+}
+
+float ChargingStation::connectorPower(int slot, float startTime, float endTime) const {
+    const ChargingDock& dock = docks[slot];
+    if (dock.cabinet == -1) return (float)dock.powerRating;
+    const PowerCabinet& c = cabinets[dock.cabinet];
+    unsigned int active = 1u << slot;
+    for (unsigned int rest = c.connectors & ~active; rest != 0; rest &= rest - 1) {
+        int i = __builtin_ctz(rest);
+        if (!schedules[i].isFree(startTime, endTime)) active |= 1u << i;
+    }
+    return min((float)dock.powerRating, c.shareLevel(active, docks));
+}
+
+void ChargingStation::setOccupied(int slot, bool occupied) {
+    if (docks[slot].isOccupied == occupied) return;
+    int cabinet = docks[slot].cabinet;
+    unsigned int affected = (cabinet == -1) ? 1u << slot : cabinets[cabinet].connectors;
+    applyPhaseDraw(affected, -1.0f);
+    docks[slot].isOccupied = occupied;
+    if (cabinet != -1) cabinets[cabinet].rebalance(docks);
+    applyPhaseDraw(affected, 1.0f);
+}
+
+void ChargingStation::applyPhaseDraw(unsigned int slots, float sign) {
+    for (unsigned int rest = slots; rest != 0; rest &= rest - 1) {
+        const ChargingDock& dock = docks[__builtin_ctz(rest)];
+        if (!dock.isOccupied || dock.phaseMask == 0) continue;
+        float draw = (dock.cabinet == -1) ? dock.powerRating : dock.allocatedKW;
+        draw *= sign / __builtin_popcount(dock.phaseMask);
+        for (int p = 0; p < PHASES; p++) {
+            if (dock.phaseMask & (1u << p)) phaseLoad[p] += draw;
+        }
+    }
+}
+
+bool ChargingStation::setDockPhases(int dockID, unsigned int phases) {
+    int slot = dockSlot(dockID);
+    phases &= ALL_PHASES;
+    if (slot == -1 || phases == 0) {
+        *log << "Invalid dock ID or phases!" << endl;
+        return false;
+    }
+    applyPhaseDraw(1u << slot, -1.0f);
+    for (const ScheduleEntry& e : schedules[slot].entries) removePhaseLoad(e.bookingIndex);
+    docks[slot].phaseMask = phases;
+    applyPhaseDraw(1u << slot, 1.0f);
+    for (const ScheduleEntry& e : schedules[slot].entries) addPhaseLoad(e.bookingIndex);
+    return true;
+}
+
+void ChargingStation::setPhaseBalancing(bool enabled, float limitKW) {
+    phaseLimitKW = max(0.0f, limitKW);
+    if (enabled == phaseBalancing) return;
+    // Bookings already on the dock schedules are recorded, or dropped
+    if (!enabled) {
+        for (int d = 0; d < MAX_DOCKS; d++) {
+            for (const ScheduleEntry& e : schedules[d].entries) removePhaseLoad(e.bookingIndex);
+        }
+    }
+    phaseBalancing = enabled;
+    if (enabled) {
+        while (phaseBuckets.nodeCount() < PHASES) phaseBuckets.addNode(-1, 0.0f);
+        for (int d = 0; d < MAX_DOCKS; d++) {
+            for (const ScheduleEntry& e : schedules[d].entries) addPhaseLoad(e.bookingIndex);
+        }
+    }
+}
+
+void ChargingStation::phaseLoadOver(float startTime, float endTime, float* load) const {
+    for (int p = 0; p < PHASES; p++) load[p] = phaseBalancing ? phaseBuckets.peakLoad(p, startTime, endTime) : 0.0f;
+}
+
+void ChargingStation::addPhaseLoad(int bookingIndex) {
+    Booking& b = bookings[bookingIndex];
+    unsigned int mask = docks[b.dockSlot].phaseMask;
+    if (!phaseBalancing || mask == 0) return;
+    float end = b.startTime + b.duration;
+    b.phaseKW = connectorPower(b.dockSlot, b.startTime, end);
+    float draw = b.phaseKW / __builtin_popcount(mask);
+    for (int p = 0; p < PHASES; p++) {
+        if (mask & (1u << p)) phaseBuckets.addLoad(p, b.startTime, end, draw);
+    }
+}
+
+void ChargingStation::removePhaseLoad(int bookingIndex) {
+    const Booking& b = bookings[bookingIndex];
+    unsigned int mask = docks[b.dockSlot].phaseMask;
+    if (!phaseBalancing || mask == 0) return;
+    float draw = -b.phaseKW / __builtin_popcount(mask);
+    for (int p = 0; p < PHASES; p++) {
+        if (mask & (1u << p)) phaseBuckets.addLoad(p, b.startTime, b.startTime + b.duration, draw);
+    }
+}
+
+bool ChargingStation::phaseFits(int slot, float startTime, float endTime, const float* load, float& imbalance) const {
+    const ChargingDock& dock = docks[slot];
+    float draw = connectorPower(slot, startTime, endTime) / __builtin_popcount(dock.phaseMask);
+    float lowest = 0.0f, highest = 0.0f;
+    for (int p = 0; p < PHASES; p++) {
+        float total = load[p] + ((dock.phaseMask & (1u << p)) ? draw : 0.0f);
+        if (phaseLimitKW > 0.0f && total > phaseLimitKW) return false;
+        if (p == 0 || total < lowest) lowest = total;
+        if (p == 0 || total > highest) highest = total;
+    }
+    imbalance = highest - lowest;
+    return true;
+}
+
+float ChargingStation::phaseFactor(int slot) const {
+    float factor = 1.0f;
+    if (phaseLimitKW <= 0.0f) return factor;
+    for (int p = 0; p < PHASES; p++) {
+        if ((docks[slot].phaseMask & (1u << p)) && phaseLoad[p] > phaseLimitKW) {
+            factor = min(factor, phaseLimitKW / phaseLoad[p]);
+        }
+    }
+    return factor;
+}
+
+float ChargingStation::getPhaseLoad(int phase) const {
+    return (phase >= 0 && phase < PHASES) ? phaseLoad[phase] : 0.0f;
+}
+
+bool ChargingStation::setBookingCapacity(int capacity) {
+    if (capacity < bookingCount) {
+        *log << "Booking capacity cannot be below the current booking count!" << endl;
+        return false;
+    }
+    bookings.resize(capacity);
+    bookingCapacity = capacity;
+    return true;
+}
+
+int ChargingStation::findUserIndex(int userID) const {
+    for (int i = 0; i < userCount; i++) {
+        if (users[i].userID == userID && users[i].isRegistered) return i;
+    }
+    return -1;
+}
+
+int ChargingStation::findVehicleIndex(int vehicleID, int userID) const {
+    for (int i = 0; i < vehicleCount; i++) {
+        if (vehicles[i].vehicleID == vehicleID && vehicles[i].userID == userID) return i;
+    }
+    return -1;
+}
+
+unsigned int ChargingStation::compatibleDocks(int vehicleIndex, int powerRating, unsigned int& preferred) const {
+    const EV& ev = vehicles[vehicleIndex];
+    unsigned int fits = 0;
+    for (int c = 0; c < CONNECTOR_TYPES; c++) {
+        if (ev.connectorMask & (1u << c)) fits |= connectorDocks[c];
+    }
+    if (ev.maxDCPowerKW <= 0.0f) fits &= ~dcDocks;
+    if (ev.maxACPowerKW <= 0.0f) fits &= dcDocks;
+
+    // A dock is oversized if the vehicle takes less than its rating and less
+    // than requested; requests the vehicle cannot take anywhere match any dock
+    preferred = fits;
+    for (unsigned int rest = fits; rest != 0; rest &= rest - 1) {
+        int i = __builtin_ctz(rest);
+        float accepted = ev.acceptancePower(docks[i].isDC);
+        if (accepted < docks[i].powerRating && accepted >= powerRating) preferred &= ~(1u << i);
+    }
+    return fits;
+}
+
+float ChargingStation::effectivePower(int slot, int vehicleIndex) const {
+    float power = docks[slot].energySource->getAvailablePower(docks[slot].powerRating);
+    if (vehicleIndex == -1) return power;
+    return min(power, vehicles[vehicleIndex].acceptancePower(docks[slot].isDC));
+}
+
+float ChargingStation::sessionEnergy(int bookingIndex) const {
+    const Booking& b = bookings[bookingIndex];
+    int slot = b.dockSlot;
+    int v = findVehicleIndex(b.vehicleID, b.userID);
+    const ChargingDock& dock = docks[slot];
+    float gridLimit = (b.gridKW >= 0.0f) ? b.gridKW : numeric_limits<float>::max();
+    if (dock.cabinet == -1) return min(effectivePower(slot, v), gridLimit) * b.duration;
+
+    // Sweep the other connectors' bookings overlapping this one, both those
+    // still scheduled and those already completed, so the share does not
+    // depend on the order sessions are completed in. Bookings of one dock
+    // never overlap, so a bit per connector tracks who is drawing.
+    float start = b.startTime, end = b.startTime + b.duration;
+    const PowerCabinet& c = cabinets[dock.cabinet];
+    unsigned int others = c.connectors & ~(1u << slot);
+    vector<pair<float, int>> events; // (time, slot + 1 on start or -(slot + 1) on end)
+    for (unsigned int rest = others; rest != 0; rest &= rest - 1) {
+        int i = __builtin_ctz(rest);
+        const vector<ScheduleEntry>& entries = schedules[i].entries;
+        int k = schedules[i].lowerBound(start);
+        if (k > 0 && entries[k - 1].end > start) k--;
+        for (; k < (int)entries.size() && entries[k].start < end; k++) {
+            events.push_back(make_pair(max(entries[k].start, start), i + 1));
+            events.push_back(make_pair(min(entries[k].end, end), -(i + 1)));
+        }
+    }
+    timeIndex.forEachOverlapping(start, end, [this, others, start, end, &events](const IndexEntry& e) {
+        const Booking& o = bookings[e.bookingIndex];
+        float oEnd = o.startTime + o.duration;
+        if (!o.isCompleted || !(others & (1u << o.dockSlot)) || oEnd <= start) return;
+        events.push_back(make_pair(max(o.startTime, start), o.dockSlot + 1));
+        events.push_back(make_pair(min(oEnd, end), -(o.dockSlot + 1)));
+    });
+    sort(events.begin(), events.end());
+
+    float accepted = (v == -1) ? (float)dock.powerRating : vehicles[v].acceptancePower(dock.isDC);
+    unsigned int active = 1u << slot;
+    float energy = 0.0f, t = start;
+    for (size_t e = 0; e <= events.size(); e++) {
+        float next = (e < events.size()) ? events[e].first : end;
+        if (next > t) {
+            float share = min((float)dock.powerRating, c.shareLevel(active, docks));
+            energy += min(min(dock.energySource->getAvailablePower(share), accepted), gridLimit) * (next - t);
+            t = next;
+        }
+        if (e < events.size()) {
+            int i = abs(events[e].second) - 1;
+            if (events[e].second > 0) active |= 1u << i;
+            else active &= ~(1u << i);
+        }
+    }
+    return energy;
+}
+
+void ChargingStation::reserveDock(int slot, int bookingIndex) {
+    reserveDock(slot, bookingIndex, schedules[slot].lowerBound(bookings[bookingIndex].startTime));
+}
+
+void ChargingStation::reserveDock(int slot, int bookingIndex, int pos) {
+    const Booking& b = bookings[bookingIndex];
+    schedules[slot].insertAt(pos, b.startTime, b.startTime + b.duration, bookingIndex);
+    setOccupied(slot, true);
+    docks[slot].currentVehicleID = bookings[schedules[slot].entries[0].bookingIndex].vehicleID;
+    scheduledTime[slot] += b.duration;
+    addGridLoad(bookingIndex);
+    addPhaseLoad(bookingIndex);
+}
+
+void ChargingStation::releaseDock(int slot, int bookingIndex) {
+    const Booking& b = bookings[bookingIndex];
+    removeGridLoad(bookingIndex);
+    removePhaseLoad(bookingIndex);
+    schedules[slot].remove(b.startTime, bookingIndex);
+    scheduledTime[slot] -= b.duration;
+    if (schedules[slot].empty()) {
+        setOccupied(slot, false);
+        docks[slot].currentVehicleID = -1;
+    } else {
+        docks[slot].currentVehicleID = bookings[schedules[slot].entries[0].bookingIndex].vehicleID;
+    }
+}
+
+int ChargingStation::powerRatingFor(int chargingType) {
+    if (chargingType == 2) return MEDIUM;
+    if (chargingType == 3) return FAST;
+    if (chargingType == 4) return SOLAR;
+    return SLOW;
+}
+
+int ChargingStation::placeBooking(int uID, int vID, int slot, float startTime, float duration, int chargingType) {
+    if (bookingCount >= bookingCapacity) {
+        *log << "Maximum booking limit reached or invalid bookingCount!" << endl;
+        return -1;
+    }
+    if (powerHeadroom(startTime, startTime + duration) < powerRatingFor(chargingType)) {
+        *log << "Insufficient grid capacity for the requested interval!" << endl;
+        return -1;
+    }
+    return admitBooking(uID, vID, slot, startTime, duration, chargingType);
+}
+
+int ChargingStation::admitBooking(int uID, int vID, int slot, float startTime, float duration, int chargingType,
+                                  int schedulePos) {
+    int index = bookingCount;
+    bookings[index].createBooking(index + 1, uID, vID, docks[slot].dockID, slot, stationID, startTime, duration, chargingType);
+    if (schedulePos == -1) reserveDock(slot, index);
+    else reserveDock(slot, index, schedulePos);
+    timeIndex.insert(startTime, startTime + duration, index);
+    bookingCount++;
+    fairShare.recordServed(userTier(uID), sessionEnergy(index), startTime);
+    return index;
+}
+
+void ChargingStation::attachLedger(BillingLedger* ledger, int month) {
+    billing = ledger;
+    billingMonth = month;
+}
+
+void ChargingStation::attachIdempotencyTable(IdempotencyTable* table) {
+    idempotency = table;
+}
+
+void ChargingStation::attachPowerTree(PowerConstraintTree* tree, int node) {
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        for (const ScheduleEntry& e : schedules[d].entries) removeGridLoad(e.bookingIndex);
+    }
+    powerTree = tree;
+    powerNode = node;
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        for (const ScheduleEntry& e : schedules[d].entries) addGridLoad(e.bookingIndex);
+    }
+}
+
+float ChargingStation::powerHeadroom(float startTime, float endTime) const {
+    if (powerTree == nullptr) return numeric_limits<float>::max();
+    return powerTree->headroom(powerNode, startTime, endTime);
+}
+
+void ChargingStation::addGridLoad(int bookingIndex) {
+    Booking& b = bookings[bookingIndex];
+    if (powerTree == nullptr) {
+        b.gridKW = -1.0f;
+        return;
+    }
+    float end = b.startTime + b.duration;
+    float power = min(effectivePower(b.dockSlot, findVehicleIndex(b.vehicleID, b.userID)),
+                      docks[b.dockSlot].energySource->getAvailablePower(connectorPower(b.dockSlot, b.startTime, end)));
+    b.gridKW = max(0.0f, min(power, powerHeadroom(b.startTime, end)));
+    powerTree->addLoad(powerNode, b.startTime, end, b.gridKW);
+    b.gridLoaded = true;
+}
+
+void ChargingStation::removeGridLoad(int bookingIndex) {
+    Booking& b = bookings[bookingIndex];
+    if (powerTree == nullptr || !b.gridLoaded) return;
+    powerTree->addLoad(powerNode, b.startTime, b.startTime + b.duration, -b.gridKW);
+    b.gridLoaded = false;
+}
+
+void ChargingStation::setLog(ostream* os) {
+    log = os;
+}
+
+void ChargingStation::notifyUser(int userID, const string& msg, float value) {
+    *log << "\n[Notification for User ID: " << userID << "] " << msg;
+    if (value >= 0.0f) *log << " " << value;
+    *log << endl;
+}
+
+bool ChargingStation::registerUser(int id, const char* name, int level) {
+    if (userCount >= MAX_USERS) {
+        *log << "Maximum user limit reached!" << endl;
+        return false;
+    }
+    for (int i = 0; i < userCount; i++) {
+        if (users[i].userID == id) {
+            *log << "User ID already exists!" << endl;
+            return false;
+        }
+    }
+    users[userCount].registerUser(id, name, level);
+    userCount++;
+    *log << "User registered successfully! Station ID: " << stationID << endl;
+    return true;
+}
+
+bool ChargingStation::registerVehicle(int vID, int uID, float soc, float capacity, bool v2g) {
+    if (vehicleCount >= MAX_USERS) {
+        *log << "Maximum vehicle limit reached!" << endl;
+        return false;
+    }
+    for (int i = 0; i < userCount; i++) {
+        if (users[i].userID == uID && users[i].isRegistered) {
+            for (int j = 0; j < vehicleCount; j++) {
+                if (vehicles[j].vehicleID == vID) {
+                    *log << "Vehicle ID already exists!" << endl;
+                    return false;
+                }
+            }
+            vehicles[vehicleCount].registerVehicle(vID, uID, soc, capacity, v2g);
+            vehicleCount++;
+            *log << "Vehicle registered successfully! Station ID: " << stationID << endl;
+            return true;
+        }
+    }
+    *log << "User not found!" << endl;
+    return false;
+}
+
+bool ChargingStation::isCriticalBooking(int uID, int vID) {
+    bool isPremium = false;
+    float soc = 0.0f;
+    for (int i = 0; i < userCount; i++) {
+        if (users[i].userID == uID && users[i].membershipLevel == 1) {
+            isPremium = true;
+            break;
+        }
+    }
+    for (int i = 0; i < vehicleCount; i++) {
+        if (vehicles[i].vehicleID == vID) {
+            soc = vehicles[i].batterySOC;
+            break;
+        }
+    }
+    return isPremium || soc < 20.0f;
+}
+
+int ChargingStation::userTier(int uID) const {
+    int u = findUserIndex(uID);
+    return (u == -1) ? 0 : users[u].membershipLevel;
+}
+
+void ChargingStation::setFairShare(bool enabled) {
+    fairShareEnabled = enabled;
+}
+
+bool ChargingStation::bypassesPeakDeferral(int uID, int vID) {
+    if (!isCriticalBooking(uID, vID)) return false;
+    return !fairShareEnabled || !fairShare.isOverShare(userTier(uID));
+}
+
+void ChargingStation::queueBooking(const QueuedBooking& qb) {
+    bookingQueues[userTier(qb.userID)].push(qb);
+}
+
+bool ChargingStation::isDockAvailable(int dockID, float startTime, float duration) {
+    if (bookingCount < 0 || bookingCount > bookingCapacity) {
+        *log << "[ERROR] Invalid bookingCount: " << bookingCount << endl;
+        return false;
+    }
+    int slot = dockSlot(dockID);
+    if (slot == -1) return false;
+    return schedules[slot].isFree(startTime, startTime + duration);
+}
+
+int ChargingStation::findAvailableDock(int powerRating, float startTime, float duration, bool isSolarCharging, unsigned int allowedDocks) {
+    switch (dockPolicy) {
+        case POLICY_BEST_FIT:
+            return findAvailableDockWith<BestFitPowerPolicy>(powerRating, startTime, duration, isSolarCharging, allowedDocks);
+        case POLICY_LEAST_LOADED:
+            return findAvailableDockWith<LeastLoadedPolicy>(powerRating, startTime, duration, isSolarCharging, allowedDocks);
+        case POLICY_SOLAR_FIRST:
+            return findAvailableDockWith<SolarFirstPolicy>(powerRating, startTime, duration, isSolarCharging, allowedDocks);
+        case POLICY_WEAR_LEVELING:
+            return findAvailableDockWith<WearLevelingPolicy>(powerRating, startTime, duration, isSolarCharging, allowedDocks);
+        case POLICY_CARBON_AWARE:
+            return findAvailableDockWith<CarbonAwarePolicy>(powerRating, startTime, duration, isSolarCharging, allowedDocks);
+        default:
+            return findAvailableDockWith<DefaultDockPolicy>(powerRating, startTime, duration, isSolarCharging, allowedDocks);
+    }
+}
+
+int ChargingStation::findVehicleDock(int vehicleIndex, int powerRating, float startTime, float duration, bool isSolarCharging) {
+    if (vehicleIndex == -1) return findAvailableDock(powerRating, startTime, duration, isSolarCharging);
+    unsigned int preferred;
+    unsigned int compatible = compatibleDocks(vehicleIndex, powerRating, preferred);
+    if (preferred != compatible) {
+        int dockID = findAvailableDock(powerRating, startTime, duration, isSolarCharging, preferred);
+        if (dockID != -1) return dockID;
+    }
+    return findAvailableDock(powerRating, startTime, duration, isSolarCharging, compatible);
+}
+
+void ChargingStation::setDockPolicy(DockPolicy policy) {
+    dockPolicy = policy;
+    *log << "Dock selection policy for Station " << stationID << " set to " << dockPolicyName(policy) << endl;
+}
+
+float ChargingStation::getCurrentPowerConsumption() {
+    float totalPower = 0.0f;
+    for (int i = 0; i < MAX_DOCKS; i++) {
+        if (docks[i].isOccupied && docks[i].energySource != nullptr) {
+            float power = (docks[i].cabinet == -1) ? docks[i].powerRating : docks[i].allocatedKW;
+            totalPower += docks[i].energySource->getAvailablePower(power * phaseFactor(i));
+        }
+    }
+    return totalPower;
+}
+
+bool ChargingStation::createBooking(int uID, int vID, float startTime, float duration, int powerRating, int chargingType) {
+    if (bookingCount < 0 || bookingCount >= bookingCapacity) {
+        *log << "Maximum booking limit reached or invalid bookingCount!" << endl;
+        return false;
+    }
+    if (startTime < 0.0f || startTime >= 24.0f || duration <= 0.0f) {
+        *log << "Invalid start time or duration!" << endl;
+        return false;
+    }
+
+    bool userExists = false;
+    for (int i = 0; i < userCount; i++) {
+        if (users[i].userID == uID && users[i].isRegistered) {
+            userExists = true;
+            break;
+        }
+    }
+    int vehicleIndex = findVehicleIndex(vID, uID);
+    if (!userExists || vehicleIndex == -1) {
+        *log << "User or vehicle not found!" << endl;
+        return false;
+    }
+
+    if (bookingCount == 0) systemStartTime = startTime;
+
+    bool isPeakHour = (startTime >= PEAK_START && startTime < PEAK_END);
+    float adjustedStartTime = startTime;
+    if (isPeakHour && !bypassesPeakDeferral(uID, vID)) {
+        adjustedStartTime = PEAK_END;
+        notifyUser(uID, "Your booking has been deferred due to peak hours. New start time:", adjustedStartTime);
+    }
+
+    bool isSolarCharging = (chargingType == 4);
+    int dockID = findVehicleDock(vehicleIndex, powerRating, adjustedStartTime, duration, isSolarCharging);
+    vector<int> bumped;
+    if (dockID == -1 && preemptionEnabled && isCriticalBooking(uID, vID)) {
+        unsigned int preferred;
+        dockID = preemptDock(powerRating, adjustedStartTime, duration, isSolarCharging, bumped,
+                             compatibleDocks(vehicleIndex, powerRating, preferred));
+    }
+    if (dockID == -1) {
+        *log << "No available dock. Booking cannot be created." << endl;
+        return false;
+    }
+
+    admitBooking(uID, vID, dockSlot(dockID), adjustedStartTime, duration, chargingType);
+    replaceBumped(bumped);
+    notifyUser(uID, "Upcoming charging session scheduled at:", adjustedStartTime);
+    *log << "Booking created successfully! Booking ID: " << bookingCount << endl;
+    return true;
+}
+
+void ChargingStation::setPreemption(bool enabled) {
+    preemptionEnabled = enabled;
+}
+
+int ChargingStation::preemptDock(int powerRating, float startTime, float duration, bool isSolarCharging, vector<int>& bumped,
+                                 unsigned int allowedDocks) {
+    const float BUMP_PENALTY = 24.0f; // moving a booking costs more than shortening any
+    float endTime = startTime + duration;
+    if (powerHeadroom(startTime, endTime) < powerRating) return -1;
+    int bestSlot = -1, bestFirst = 0;
+    float bestCost = 0.0f;
+    for (int i = 0; i < MAX_DOCKS; i++) {
+        if (docks[i].energySource == nullptr || !(allowedDocks & (1u << i))) continue;
+        bool isSolar = dynamic_cast<SolarPower*>(docks[i].energySource) != nullptr;
+        float basePower = (docks[i].cabinet == -1) ? docks[i].powerRating : connectorPower(i, startTime, endTime);
+        if (docks[i].energySource->getAvailablePower(basePower) < powerRating || (isSolarCharging && !isSolar)) {
+            continue;
+        }
+        const vector<ScheduleEntry>& entries = schedules[i].entries;
+        int first = schedules[i].lowerBound(startTime);
+        if (first > 0 && entries[first - 1].end > startTime) first--;
+        float cost = 0.0f;
+        bool eligible = true;
+        for (int k = first; k < (int)entries.size() && entries[k].start < endTime; k++) {
+            const Booking& b = bookings[entries[k].bookingIndex];
+            if (b.isHeld || isCriticalBooking(b.userID, b.vehicleID)) {
+                eligible = false;
+                break;
+            }
+            if (b.startTime < startTime) cost += entries[k].end - startTime;
+            else cost += BUMP_PENALTY + b.duration;
+        }
+        if (eligible && (bestSlot == -1 || cost < bestCost)) {
+            bestSlot = i;
+            bestFirst = first;
+            bestCost = cost;
+        }
+    }
+    if (bestSlot == -1) return -1;
+
+    vector<int> victims;
+    const vector<ScheduleEntry>& entries = schedules[bestSlot].entries;
+    for (int k = bestFirst; k < (int)entries.size() && entries[k].start < endTime; k++) {
+        victims.push_back(entries[k].bookingIndex);
+    }
+    for (int i : victims) {
+        Booking& b = bookings[i];
+        releaseDock(bestSlot, i);
+        if (b.startTime < startTime) {
+            b.duration = startTime - b.startTime;
+            reserveDock(bestSlot, i);
+            notifyUser(b.userID, "Your booking was shortened for a priority session. New end time:", startTime);
+        } else {
+            bumped.push_back(i);
+        }
+    }
+    return docks[bestSlot].dockID;
+}
+
+void ChargingStation::replaceBumped(const vector<int>& bumped) {
+    for (int i : bumped) {
+        Booking& b = bookings[i];
+        int dockID = findVehicleDock(findVehicleIndex(b.vehicleID, b.userID), powerRatingFor(b.chargingType),
+                                     b.startTime, b.duration, b.chargingType == 4);
+        if (dockID != -1) {
+            b.dockID = dockID;
+            b.dockSlot = dockSlot(dockID);
+            reserveDock(b.dockSlot, i);
+            notifyUser(b.userID, "Your booking was moved for a priority session. New dock ID:", (float)dockID);
+        } else {
+            b.cancelBooking();
+            queueBooking(QueuedBooking(b.userID, b.vehicleID, b.startTime, b.duration,
+                                       powerRatingFor(b.chargingType), b.chargingType));
+            notifyUser(b.userID, "Your booking was bumped by a priority session and queued for rebooking.");
+        }
+    }
+}
+
+int ChargingStation::holdBooking(int uID, int vID, float startTime, float duration, int powerRating, int chargingType,
+                                 long long now, int ttlSeconds) {
+    expireHolds(now);
+    if (bookingCount < 0 || bookingCount >= bookingCapacity) {
+        *log << "Maximum booking limit reached or invalid bookingCount!" << endl;
+        return -1;
+    }
+    if (startTime < 0.0f || startTime >= 24.0f || duration <= 0.0f || ttlSeconds <= 0) {
+        *log << "Invalid start time, duration or hold time!" << endl;
+        return -1;
+    }
+    int vehicleIndex = (findUserIndex(uID) == -1) ? -1 : findVehicleIndex(vID, uID);
+    if (vehicleIndex == -1) {
+        *log << "User or vehicle not found!" << endl;
+        return -1;
+    }
+
+    if (bookingCount == 0) systemStartTime = startTime;
+
+    bool isPeakHour = (startTime >= PEAK_START && startTime < PEAK_END);
+    float adjustedStartTime = startTime;
+    if (isPeakHour && !bypassesPeakDeferral(uID, vID)) {
+        adjustedStartTime = PEAK_END;
+        notifyUser(uID, "Your booking has been deferred due to peak hours. New start time:", adjustedStartTime);
+    }
+
+    int dockID = findVehicleDock(vehicleIndex, powerRating, adjustedStartTime, duration, chargingType == 4);
+    if (dockID == -1) {
+        *log << "No available dock. Slot cannot be held." << endl;
+        return -1;
+    }
+
+    int slot = dockSlot(dockID);
+    Booking& b = bookings[bookingCount];
+    b.createBooking(bookingCount + 1, uID, vID, dockID, slot, stationID, adjustedStartTime, duration, chargingType);
+    b.isActive = false;
+    b.isHeld = true;
+    b.holdExpiry = now + ttlSeconds;
+    reserveDock(slot, bookingCount);
+    holdTimers.schedule(b.holdExpiry, bookingCount);
+    bookingCount++;
+    *log << "Slot held for " << ttlSeconds << " seconds. Booking ID: " << b.bookingID << endl;
+    return b.bookingID;
+}
+
+bool ChargingStation::confirmHold(int bookingID, long long now) {
+    expireHolds(now);
+    if (bookingID < 1 || bookingID > bookingCount || !bookings[bookingID - 1].isHeld) {
+        *log << "Hold not found or expired!" << endl;
+        return false;
+    }
+    Booking& b = bookings[bookingID - 1];
+    b.isHeld = false;
+    b.isActive = true;
+    timeIndex.insert(b.startTime, b.startTime + b.duration, bookingID - 1);
+    fairShare.recordServed(userTier(b.userID), sessionEnergy(bookingID - 1), b.startTime);
+    notifyUser(b.userID, "Upcoming charging session scheduled at:", b.startTime);
+    *log << "Booking confirmed! Booking ID: " << bookingID << endl;
+    return true;
+}
+
+bool ChargingStation::releaseHold(int bookingID) {
+    if (bookingID < 1 || bookingID > bookingCount || !bookings[bookingID - 1].isHeld) {
+        *log << "Hold not found or expired!" << endl;
+        return false;
+    }
+    bookings[bookingID - 1].expireHold();
+    releaseDock(bookings[bookingID - 1].dockSlot, bookingID - 1);
+    return true;
+}
+
+int ChargingStation::expireHolds(long long now) {
+    int expired = 0;
+    holdTimers.advance(now, [this, now, &expired](int i) {
+        Booking& b = bookings[i];
+        if (b.isHeld && b.holdExpiry <= now) {
+            b.expireHold();
+            releaseDock(b.dockSlot, i);
+            expired++;
+        }
+    });
+    return expired;
+}
+
+template <typename Operation>
+int ChargingStation::runOnce(unsigned long long requestKey, long long now, int operation, int failure, Operation run) {
+    if (idempotency == nullptr || requestKey == 0) return run();
+    IdempotentResult previous;
+    if (idempotency->lookup(requestKey, now, previous)) {
+        if (previous.stationID != stationID || previous.operation != operation) {
+            *log << "Request key already used for another operation!" << endl;
+            return failure;
+        }
+        *log << "Duplicate request ignored; returning the original result." << endl;
+        return previous.value;
+    }
+    IdempotentResult result;
+    result.stationID = stationID;
+    result.operation = operation;
+    result.value = run();
+    idempotency->record(requestKey, now, result);
+    return result.value;
+}
+
+int ChargingStation::createBookingOnce(unsigned long long requestKey, long long now, int uID, int vID, float startTime,
+                                       float duration, int powerRating, int chargingType) {
+    return runOnce(requestKey, now, OP_CREATE_BOOKING, -1, [&]() {
+        return createBooking(uID, vID, startTime, duration, powerRating, chargingType) ? bookingCount : -1;
+    });
+}
+
+int ChargingStation::cancelBookingOnce(unsigned long long requestKey, long long now, int bookingID) {
+    return runOnce(requestKey, now, OP_CANCEL_BOOKING, 0, [&]() {
+        if (bookingID < 1 || bookingID > bookingCount || !bookings[bookingID - 1].isActive) return 0;
+        cancelBooking(bookingID);
+        return bookings[bookingID - 1].isActive ? 0 : 1;
+    });
+}
+
+int ChargingStation::completeBookingOnce(unsigned long long requestKey, long long now, int bookingID) {
+    return runOnce(requestKey, now, OP_COMPLETE_BOOKING, 0, [&]() {
+        if (bookingID < 1 || bookingID > bookingCount || !bookings[bookingID - 1].isActive) return 0;
+        completeBooking(bookingID);
+        return bookings[bookingID - 1].isActive ? 0 : 1;
+    });
+}
+
+int ChargingStation::holdBookingOnce(unsigned long long requestKey, long long now, int uID, int vID, float startTime,
+                                     float duration, int powerRating, int chargingType, int ttlSeconds) {
+    return runOnce(requestKey, now, OP_HOLD_BOOKING, -1, [&]() {
+        return holdBooking(uID, vID, startTime, duration, powerRating, chargingType, now, ttlSeconds);
+    });
+}
+
+int ChargingStation::confirmHoldOnce(unsigned long long requestKey, long long now, int bookingID) {
+    return runOnce(requestKey, now, OP_CONFIRM_HOLD, 0, [&]() {
+        return confirmHold(bookingID, now) ? 1 : 0;
+    });
+}
+
+int ChargingStation::createBookings(const BookingRequest* requests, int count, BookingResult* results) {
+    switch (dockPolicy) {
+        case POLICY_BEST_FIT:
+            return createBookingsWith<BestFitPowerPolicy>(requests, count, results);
+        case POLICY_LEAST_LOADED:
+            return createBookingsWith<LeastLoadedPolicy>(requests, count, results);
+        case POLICY_SOLAR_FIRST:
+            return createBookingsWith<SolarFirstPolicy>(requests, count, results);
+        case POLICY_WEAR_LEVELING:
+            return createBookingsWith<WearLevelingPolicy>(requests, count, results);
+        case POLICY_CARBON_AWARE:
+            return createBookingsWith<CarbonAwarePolicy>(requests, count, results);
+        default:
+            return createBookingsWith<DefaultDockPolicy>(requests, count, results);
+    }
+}
+
+template <typename Policy>
+int ChargingStation::createBookingsWith(const BookingRequest* requests, int count, BookingResult* results) {
+    // Validate and resolve every request once, deferring peak-hour requests
+    // that are not critical. Critical ones are checked against their tier's
+    // fair share as they are admitted, since every admission changes it.
+    vector<int> order;
+    order.reserve(count);
+    vector<int> vehicleIndex(count, -1);
+    bool firstValid = true;
+    for (int r = 0; r < count; r++) {
+        const BookingRequest& q = requests[r];
+        BookingResult& res = results[r];
+        res.status = BOOKING_INVALID;
+        res.bookingID = -1;
+        res.dockID = -1;
+        res.startTime = q.startTime;
+        if (q.startTime < 0.0f || q.startTime >= 24.0f || q.duration <= 0.0f) continue;
+
+        int u = findUserIndex(q.userID);
+        int v = (u == -1) ? -1 : findVehicleIndex(q.vehicleID, q.userID);
+        if (v == -1) {
+            res.status = BOOKING_UNKNOWN_USER;
+            continue;
+        }
+        vehicleIndex[r] = v;
+        if (firstValid && bookingCount == 0) systemStartTime = q.startTime;
+        firstValid = false;
+
+        bool isPeakHour = (q.startTime >= PEAK_START && q.startTime < PEAK_END);
+        if (isPeakHour && !isCriticalBooking(q.userID, q.vehicleID)) res.startTime = PEAK_END;
+        order.push_back(r);
+    }
+
+    // Group by charging type, then sweep each group in start-time order
+    sort(order.begin(), order.end(), [requests, results](int a, int b) {
+        if (requests[a].chargingType != requests[b].chargingType) return requests[a].chargingType < requests[b].chargingType;
+        if (results[a].startTime != results[b].startTime) return results[a].startTime < results[b].startTime;
+        return a < b;
+    });
+
+    // cursor[d]: first entry of dock d's schedule ending after the current start.
+    // Starts only grow within a group, so cursors only move forward.
+    int cursor[MAX_DOCKS];
+    int accepted = 0;
+    int currentType = -1;
+    for (int r : order) {
+        const BookingRequest& q = requests[r];
+        BookingResult& res = results[r];
+        if (q.chargingType != currentType) {
+            currentType = q.chargingType;
+            for (int d = 0; d < MAX_DOCKS; d++) cursor[d] = 0;
+        }
+        if (bookingCount >= bookingCapacity) {
+            res.status = BOOKING_LIMIT_REACHED;
+            continue;
+        }
+
+        // A critical request deferred now starts after the sweep position, so
+        // it is checked and inserted by search, leaving the cursors valid
+        bool sweep = true;
+        if (res.startTime >= PEAK_START && res.startTime < PEAK_END && !bypassesPeakDeferral(q.userID, q.vehicleID)) {
+            res.startTime = PEAK_END;
+            sweep = false;
+        }
+        float start = res.startTime;
+        float end = start + q.duration;
+        auto isFree = [this, &cursor, sweep, start, end](int d) {
+            if (!sweep) return schedules[d].isFree(start, end);
+            const vector<ScheduleEntry>& entries = schedules[d].entries;
+            int& c = cursor[d];
+            while (c < (int)entries.size() && entries[c].end <= start) c++;
+            return c == (int)entries.size() || entries[c].start >= end;
+        };
+        unsigned int preferred;
+        unsigned int compatible = compatibleDocks(vehicleIndex[r], q.powerRating, preferred);
+        int slot = -1;
+        if (preferred != compatible) slot = selectDock<Policy>(q.powerRating, start, end, q.chargingType == 4, isFree, preferred);
+        if (slot == -1) slot = selectDock<Policy>(q.powerRating, start, end, q.chargingType == 4, isFree, compatible);
+        if (slot == -1) {
+            res.status = BOOKING_NO_DOCK;
+            continue;
+        }
+
+        int index = admitBooking(q.userID, q.vehicleID, slot, start, q.duration, q.chargingType, sweep ? cursor[slot] : -1);
+
+        res.status = BOOKING_OK;
+        res.bookingID = index + 1;
+        res.dockID = docks[slot].dockID;
+        accepted++;
+    }
+
+    *log << "Batch booking: " << accepted << " of " << count << " requests accepted. Station ID: " << stationID << endl;
+    return accepted;
+}
+
+void ChargingStation::cancelBooking(int bookingID) {
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].bookingID == bookingID && bookings[i].isActive) {
+            Millicents penalty = 0;
+            float timeToStart = bookings[i].startTime - systemStartTime;
+            if (timeToStart < 1.0f) penalty = 5 * MILLICENTS_PER_DOLLAR;
+            else if (timeToStart < 4.0f) penalty = 2 * MILLICENTS_PER_DOLLAR;
+            bookings[i].cancelBooking();
+            releaseDock(bookings[i].dockSlot, i);
+            if (billing != nullptr && penalty > 0 &&
+                billing->postPenalty(stationID, bookings[i].userID, bookingID, penalty, billingMonth) == -1) {
+                *log << "[ERROR] Billing ledger is full!" << endl;
+            }
+            notifyUser(bookings[i].userID, "Booking cancelled. Penalty charged: $", millicentsToDollars(penalty));
+            break;
+        }
+    }
+}
+
+int ChargingStation::addRecurringBooking(int uID, int vID, float timeOfDay, float duration, int powerRating, int chargingType,
+                                         RecurrenceKind kind, int weekdayMask, int firstDay, int lastDay) {
+    if (kind == RECUR_DAILY) weekdayMask = ALL_WEEKDAYS;
+    if (timeOfDay < 0.0f || timeOfDay >= HOURS_PER_DAY || duration <= 0.0f || firstDay < 0 ||
+        (lastDay != -1 && lastDay < firstDay) || (weekdayMask & ALL_WEEKDAYS) == 0) {
+        *log << "Invalid recurring booking!" << endl;
+        return -1;
+    }
+    if (findVehicleIndex(vID, uID) == -1 || findUserIndex(uID) == -1) {
+        *log << "User or vehicle not found!" << endl;
+        return -1;
+    }
+
+    bool isPeakHour = (timeOfDay >= PEAK_START && timeOfDay < PEAK_END);
+    if (isPeakHour && !bypassesPeakDeferral(uID, vID)) {
+        timeOfDay = PEAK_END;
+        notifyUser(uID, "Your recurring booking has been deferred due to peak hours. New start time:", timeOfDay);
+    }
+
+    RecurringRule rule;
+    rule.ruleID = (int)recurringRules.size() + 1;
+    rule.userID = uID;
+    rule.vehicleID = vID;
+    rule.timeOfDay = timeOfDay;
+    rule.duration = duration;
+    rule.powerRating = powerRating;
+    rule.chargingType = chargingType;
+    rule.weekdayMask = weekdayMask & ALL_WEEKDAYS;
+    rule.firstDay = firstDay;
+    rule.lastDay = lastDay;
+    rule.nextDay = firstDay;
+    rule.conflicts = 0;
+    rule.isActive = true;
+    recurringRules.push_back(rule);
+
+    int created = expandRule(recurringRules.back(), recurringRules.back().startOn(firstDay));
+    *log << "Recurring booking created! Rule ID: " << rule.ruleID << ", occurrences scheduled: " << created << endl;
+    return rule.ruleID;
+}
+
+bool ChargingStation::addRecurringException(int ruleID, int day) {
+    if (ruleID < 1 || ruleID > (int)recurringRules.size()) {
+        *log << "Recurring booking not found!" << endl;
+        return false;
+    }
+    RecurringRule& rule = recurringRules[ruleID - 1];
+    bool wasScheduled = rule.occursOn(day) && day < rule.nextDay;
+    rule.addException(day);
+    if (wasScheduled) {
+        vector<int> found;
+        timeIndex.forEachStarting(rule.startOn(day), rule.startOn(day + 1), [&found](const IndexEntry& e) {
+            found.push_back(e.bookingIndex);
+        });
+        for (int i : found) {
+            if (bookings[i].ruleID == ruleID && bookings[i].isActive) releaseOccurrence(i);
+        }
+    }
+    return true;
+}
+
+bool ChargingStation::cancelRecurringBooking(int ruleID, float from) {
+    if (ruleID < 1 || ruleID > (int)recurringRules.size() || !recurringRules[ruleID - 1].isActive) {
+        *log << "Recurring booking not found!" << endl;
+        return false;
+    }
+    RecurringRule& rule = recurringRules[ruleID - 1];
+    rule.isActive = false;
+    vector<int> found;
+    timeIndex.forEachStarting(from, rule.startOn(rule.nextDay), [&found](const IndexEntry& e) {
+        found.push_back(e.bookingIndex);
+    });
+    for (int i : found) {
+        if (bookings[i].ruleID == ruleID && bookings[i].isActive) releaseOccurrence(i);
+    }
+    notifyUser(rule.userID, "Recurring booking cancelled. Rule ID:", (float)ruleID);
+    return true;
+}
+
+int ChargingStation::expandRecurringBookings(float now) {
+    int created = 0;
+    for (RecurringRule& rule : recurringRules) {
+        if (rule.isActive) created += expandRule(rule, now);
+    }
+    return created;
+}
+
+void ChargingStation::setRecurringHorizon(float hours) {
+    recurringHorizon = hours;
+}
+
+int ChargingStation::expandRule(RecurringRule& rule, float now) {
+    float horizonEnd = now + recurringHorizon;
+    int created = 0;
+    while (rule.lastDay == -1 || rule.nextDay <= rule.lastDay) {
+        int day = rule.nextDay;
+        float start = rule.startOn(day);
+        if (start >= horizonEnd) break;
+        if (!rule.occursOn(day) || start < now) {
+            rule.nextDay++;
+            continue;
+        }
+        if (bookingCount >= bookingCapacity) {
+            *log << "Maximum booking limit reached or invalid bookingCount!" << endl;
+            break;
+        }
+        rule.nextDay++;
+
+        int dockID = findVehicleDock(findVehicleIndex(rule.vehicleID, rule.userID), rule.powerRating, start, rule.duration,
+                                     rule.chargingType == 4);
+        if (dockID == -1) {
+            rule.conflicts++;
+            notifyUser(rule.userID, "Recurring booking skipped, no dock available at:", start);
+            continue;
+        }
+        int index = placeBooking(rule.userID, rule.vehicleID, dockSlot(dockID), start, rule.duration, rule.chargingType);
+        if (index == -1) {
+            rule.conflicts++;
+            continue;
+        }
+        bookings[index].ruleID = rule.ruleID;
+        created++;
+    }
+    return created;
+}
+
+void ChargingStation::releaseOccurrence(int bookingIndex) {
+    bookings[bookingIndex].cancelBooking();
+    releaseDock(bookings[bookingIndex].dockSlot, bookingIndex);
+}
+
+void ChargingStation::processQueue() {
+    while (true) {
+        bool waiting[MEMBERSHIP_TIERS];
+        for (int t = 0; t < MEMBERSHIP_TIERS; t++) waiting[t] = !bookingQueues[t].empty();
+        int tier = fairShare.pickTier(waiting);
+        if (tier == -1) break;
+        QueuedBooking qb = bookingQueues[tier].front();
+        if (createBooking(qb.userID, qb.vehicleID, qb.startTime, qb.duration, qb.powerRating, qb.chargingType)) {
+            bookingQueues[tier].pop();
+        } else {
+            break;
+        }
+    }
+}
+
+Invoice ChargingStation::priceBooking(int bookingIndex) const {
+    const Booking& b = bookings[bookingIndex];
+    const ChargingDock& dock = docks[b.dockSlot];
+    Invoice inv;
+    inv.bookingID = b.bookingID;
+    inv.userID = b.userID;
+    inv.vehicleID = b.vehicleID;
+    inv.dockID = b.dockID;
+
+    // Metered energy when the dock reported any, otherwise the estimate
+    WattHours energy = (b.measuredWh >= 0) ? b.measuredWh : kWhToWattHours(sessionEnergy(bookingIndex));
+
+    // Rates in millicents per kWh; multipliers are applied in thousandths
+    Millicents rate = 0;
+    if (b.chargingType == 1) rate = 20000; // Slow, $0.20
+    else if (b.chargingType == 2) rate = 30000; // Medium, $0.30
+    else if (b.chargingType == 3) rate = 40000; // Fast, $0.40
+    else if (b.chargingType == 4) rate = 15000; // Solar, $0.15
+
+    // Apply a discount for solar charging
+    if (b.chargingType == 4) {
+        rate = scalePermille(rate, 850); // 15% discount for solar charging
+    }
+
+    float hourOfDay = fmod(b.startTime, (float)HOURS_PER_DAY);
+    if (hourOfDay >= PEAK_START && hourOfDay < PEAK_END) {
+        rate = scalePermille(rate, 1200); // Peak hour surcharge
+    }
+    rate = scalePermille(rate, toPermille(dock.energySource->getRateAdjustment()));
+
+    Millicents cost = scalePermille(energy, rate); // Wh * (millicents/kWh) / 1000
+    for (int j = 0; j < userCount; j++) {
+        if (users[j].userID == b.userID && users[j].membershipLevel == 1) {
+            cost = scalePermille(cost, 850); // 15% discount for premium members
+            break;
+        }
+    }
+
+    inv.energyWh = energy;
+    inv.rateMillicentsPerKWh = rate;
+    inv.costMillicents = cost;
+    return inv;
+}
+
+void ChargingStation::completeBooking(int bookingID) {
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].bookingID == bookingID && bookings[i].isActive) {
+            int dockIndex = bookings[i].dockSlot;
+            bool validDock = dockIndex != -1 && docks[dockIndex].energySource != nullptr;
+            // Price while the booking still holds its grid allocation
+            Invoice inv = Invoice();
+            if (validDock) inv = priceBooking(i);
+            bookings[i].completeBooking();
+            if (dockIndex != -1) {
+                releaseDock(dockIndex, i);
+                completedSessions[dockIndex]++;
+            }
+            if (!validDock) {
+                *log << "Error: Invalid dock or energy source!" << endl;
+                return;
+            }
+            float energy = wattHoursToKWh(inv.energyWh);
+            bookings[i].energyWh = inv.energyWh;
+            bookings[i].costMillicents = inv.costMillicents;
+            if (billing != nullptr &&
+                billing->postCharge(stationID, bookings[i].userID, bookingID, inv.costMillicents, billingMonth) == -1) {
+                *log << "[ERROR] Billing ledger is full!" << endl;
+            }
+            totalOccupiedTime[dockIndex] += bookings[i].duration;
+
+            for (int j = 0; j < vehicleCount; j++) {
+                if (vehicles[j].vehicleID == bookings[i].vehicleID) {
+                    vehicles[j].batterySOC += (energy / vehicles[j].batteryCapacity) * 100.0f;
+                    if (vehicles[j].batterySOC > 100.0f) vehicles[j].batterySOC = 100.0f;
+                    break;
+                }
+            }
+
+            *log << "Invoice for Booking ID: " << bookingID << endl;
+            *log << "User  ID: " << bookings[i].userID << endl;
+            *log << "Vehicle ID: " << bookings[i].vehicleID << endl;
+            *log << "Energy Consumed: " << energy << " kWh" << endl;
+            *log << "Charging Rate: $" << millicentsToDollars(inv.rateMillicentsPerKWh) << " per kWh" << endl;
+            *log << "Total Cost: $" << millicentsToDollars(inv.costMillicents) << endl;
+
+            notifyUser (bookings[i].userID, "Charging session completed. Energy consumed:", energy);
+            notifyUser (bookings[i].userID, "Total cost for the session: $", millicentsToDollars(inv.costMillicents));
+
+            break;
+        }
+    }
+}
+
+int ChargingStation::settleBookings(float endTime, vector<Invoice>& ledger, int threadCount) {
+    // Dock schedules are sorted by end time, so the sessions to settle are a
+    // prefix of each schedule. Holds in the prefix were never confirmed and
+    // are dropped instead.
+    vector<int> due;
+    vector<int> staleHolds;
+    int prefix[MAX_DOCKS];
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        const vector<ScheduleEntry>& entries = schedules[d].entries;
+        int k = 0;
+        while (k < (int)entries.size() && entries[k].end <= endTime) k++;
+        prefix[d] = k;
+        if (docks[d].energySource == nullptr) continue;
+        for (int j = 0; j < k; j++) {
+            int i = entries[j].bookingIndex;
+            if (bookings[i].isHeld) staleHolds.push_back(i);
+            else due.push_back(i);
+        }
+    }
+    sort(due.begin(), due.end());
+    int n = (int)due.size();
+
+    // Price sessions and SOC gains in parallel; workers inherit this thread's weather
+    vector<Invoice> invoices(n);
+    vector<int> vehicleIndex(n);
+    vector<float> socGain(n);
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > n) threadCount = max(1, n);
+    vector<Millicents> revenue(threadCount, 0);
+    vector<char> overflow(threadCount, 0);
+    auto priceRange = [this, &due, &invoices, &vehicleIndex, &socGain, &revenue, &overflow](int t, int begin, int end, WeatherCondition weather) {
+        currentWeather = weather;
+        for (int k = begin; k < end; k++) {
+            invoices[k] = priceBooking(due[k]);
+            vehicleIndex[k] = -1;
+            socGain[k] = 0.0f;
+            for (int j = 0; j < vehicleCount; j++) {
+                if (vehicles[j].vehicleID == invoices[k].vehicleID) {
+                    vehicleIndex[k] = j;
+                    socGain[k] = (wattHoursToKWh(invoices[k].energyWh) / vehicles[j].batteryCapacity) * 100.0f;
+                    break;
+                }
+            }
+            if (!addChecked(revenue[t], invoices[k].costMillicents)) overflow[t] = 1;
+        }
+    };
+    if (threadCount == 1) {
+        priceRange(0, 0, n, currentWeather);
+    } else {
+        vector<thread> workers;
+        for (int t = 0; t < threadCount; t++) {
+            int begin = (int)((long long)n * t / threadCount);
+            int end = (int)((long long)n * (t + 1) / threadCount);
+            workers.emplace_back(priceRange, t, begin, end, currentWeather);
+        }
+        for (thread& w : workers) w.join();
+    }
+
+    // Integer partial sums combine to the same total for any thread count
+    Millicents totalRevenue = 0;
+    bool revenueOverflow = false;
+    for (int t = 0; t < threadCount; t++) {
+        if (overflow[t] || !addChecked(totalRevenue, revenue[t])) revenueOverflow = true;
+    }
+    if (revenueOverflow) *log << "[ERROR] Settlement revenue total overflowed!" << endl;
+
+    // Apply results in booking order and append them to the ledger
+    ledger.reserve(ledger.size() + n);
+    bool billingFull = false;
+    for (int k = 0; k < n; k++) {
+        Booking& b = bookings[due[k]];
+        b.completeBooking();
+        removeGridLoad(due[k]);
+        removePhaseLoad(due[k]);
+        b.energyWh = invoices[k].energyWh;
+        b.costMillicents = invoices[k].costMillicents;
+        totalOccupiedTime[b.dockSlot] += b.duration;
+        scheduledTime[b.dockSlot] -= b.duration;
+        completedSessions[b.dockSlot]++;
+        if (vehicleIndex[k] != -1) {
+            EV& v = vehicles[vehicleIndex[k]];
+            v.batterySOC += socGain[k];
+            if (v.batterySOC > 100.0f) v.batterySOC = 100.0f;
+        }
+        ledger.push_back(invoices[k]);
+        if (billing != nullptr &&
+            billing->postCharge(stationID, b.userID, b.bookingID, invoices[k].costMillicents, billingMonth) == -1) {
+            billingFull = true;
+        }
+    }
+    if (billingFull) *log << "[ERROR] Billing ledger is full!" << endl;
+    for (int i : staleHolds) {
+        removeGridLoad(i);
+        removePhaseLoad(i);
+        bookings[i].expireHold();
+        scheduledTime[bookings[i].dockSlot] -= bookings[i].duration;
+    }
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        if (docks[d].energySource == nullptr || prefix[d] == 0) continue;
+        schedules[d].erasePrefix(prefix[d]);
+        const vector<ScheduleEntry>& entries = schedules[d].entries;
+        if (entries.empty()) {
+            setOccupied(d, false);
+            docks[d].currentVehicleID = -1;
+        } else {
+            docks[d].currentVehicleID = bookings[entries[0].bookingIndex].vehicleID;
+        }
+    }
+
+    *log << "Settlement: " << n << " sessions settled up to " << endTime << ", revenue $"
+         << millicentsToDollars(totalRevenue) << ". Station ID: " << stationID << endl;
+    return n;
+}
+
+void ChargingStation::displayRealTimeData() {
+    *log << "\n=== Real-Time Charging Data ===\n";
+    bool activeFound = false;
+    // For demonstration, consider current time = systemStartTime + 1.0 to simulate elapsed time
+    float currentTime = systemStartTime + 1.0f;
+
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].isActive) {
+            activeFound = true;
+            float elapsedTime = currentTime - bookings[i].startTime;
+            if (elapsedTime < 0.0f) elapsedTime = 0.0f;
+            if (elapsedTime > bookings[i].duration) elapsedTime = bookings[i].duration;
+
+            int dockIndex = bookings[i].dockSlot;
+            if (dockIndex == -1 || docks[dockIndex].energySource == nullptr) {
+                *log << "Error: Invalid dock for booking " << bookings[i].bookingID << endl;
+                continue;
+            }
+            float energySoFar = effectivePower(dockIndex, findVehicleIndex(bookings[i].vehicleID, bookings[i].userID)) * elapsedTime;
+            float remainingTime = bookings[i].duration - elapsedTime;
+            *log << "Booking ID: " << bookings[i].bookingID << endl;
+            *log << "Vehicle ID: " << bookings[i].vehicleID << endl;
+            *log << "Energy Delivered: " << energySoFar << " kWh" << endl;
+            *log << "Remaining Time: " << remainingTime << " hours" << endl;
+            *log << "------------------------" << endl;
+        }
+    }
+    if (!activeFound) {
+        *log << "No active bookings." << endl;
+    }
+}
+
+void ChargingStation::generateReport() {
+    *log << "\n=== Charging Station Analytics Report ===\n";
+    float totalSystemTime = 0.0f;
+    float totalOccupied = 0.0f;
+    float latestEndTime = systemStartTime;
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].isHeld || bookings[i].isExpired) continue;
+        float endTime = bookings[i].startTime + bookings[i].duration;
+        if (endTime > latestEndTime) latestEndTime = endTime;
+    }
+    if (bookingCount > 0) totalSystemTime = latestEndTime - systemStartTime;
+    for (int i = 0; i < MAX_DOCKS; i++) totalOccupied += totalOccupiedTime[i];
+    float utilization = (totalSystemTime > 0.0f) ? (totalOccupied / (totalSystemTime * MAX_DOCKS)) * 100.0f : 0.0f;
+    *log << "Station Utilization: " << utilization << "%" << endl;
+
+    float totalDuration = 0.0f;
+    int completedBookings = 0;
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].isFinished()) {
+            totalDuration += bookings[i].duration;
+            completedBookings++;
+        }
+    }
+    float avgDuration = (completedBookings > 0) ? totalDuration / completedBookings : 0.0f;
+    *log << "Average Session Duration: " << avgDuration << " hours" << endl;
+
+    WattHours gridEnergy = 0, solarEnergy = 0;
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].isFinished()) {
+            const ChargingDock& dock = docks[bookings[i].dockSlot];
+            if (dock.energySource != nullptr) {
+                if (dynamic_cast<GridPower*>(dock.energySource)) {
+                    gridEnergy += bookings[i].energyWh;
+                } else {
+                    solarEnergy += bookings[i].energyWh;
+                }
+            }
+        }
+    }
+    WattHours totalEnergy = gridEnergy + solarEnergy;
+    float gridRatio = (totalEnergy > 0) ? ((float)gridEnergy / totalEnergy) * 100.0f : 0.0f;
+    float solarRatio = (totalEnergy > 0) ? ((float)solarEnergy / totalEnergy) * 100.0f : 0.0f;
+    *log << "Energy Source Ratios: Grid: " << gridRatio << "%, Solar: " << solarRatio << "%" << endl;
+
+    int regularBookings = 0, premiumBookings = 0;
+    for (int i = 0; i < bookingCount; i++) {
+        for (int j = 0; j < userCount; j++) {
+            if (users[j].userID == bookings[i].userID) {
+                if (users[j].membershipLevel == 0) regularBookings++;
+                else premiumBookings++;
+                break;
+            }
+        }
+    }
+    *log << "User Demand Trends: Regular Bookings: " << regularBookings << ", Premium Bookings: " << premiumBookings << endl;
+
+    Millicents totalRevenue = 0;
+    bool revenueOverflow = false;
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].isFinished() && !addChecked(totalRevenue, bookings[i].costMillicents)) revenueOverflow = true;
+    }
+    if (revenueOverflow) *log << "[ERROR] Revenue total overflowed!" << endl;
+    *log << "Total Revenue: $" << millicentsToDollars(totalRevenue) << endl;
+
+    float co2Savings = 0.0f;
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].isFinished()) {
+            const ChargingDock& dock = docks[bookings[i].dockSlot];
+            if (dock.energySource != nullptr) {
+                co2Savings += dock.energySource->getCO2Emission(wattHoursToKWh(bookings[i].energyWh));
+            }
+        }
+    }
+    *log << "Environmental Impact: CO2 Savings: " << co2Savings << " kg" << endl;
+
+    *log << "=====================================\n";
+}
+
+void ChargingStation::displayDockStatus() {
+    *log << "\n=== Charging Station Dock Status ===\n";
+    *log << left << setw(10) << "Dock ID" << setw(15) << "Power (kW)" << setw(15) << "Source" << setw(25) << "Status" << endl;
+    *log << string(65, '-') << endl;
+    for (int i = 0; i < MAX_DOCKS; i++) {
+        if (docks[i].energySource == nullptr) {
+            *log << "Error: Dock " << docks[i].dockID << " has null energy source!" << endl;
+            continue;
+        }
+        *log << left << setw(10) << docks[i].dockID
+             << setw(15) << docks[i].powerRating
+             << setw(15) << docks[i].energySource->getSourceName();
+        if (docks[i].isOccupied) {
+            *log << "Occupied (Vehicle ID: " << docks[i].currentVehicleID << ")";
+        } else {
+            *log << "Available";
+        }
+        *log << endl;
+    }
+    *log << "=====================================\n";
+}
+
+void ChargingStation::displayDockCalendar(float from, float to) {
+    *log << "\n=== Dock Calendar " << from << " - " << to << " ===\n";
+    vector<CalendarInterval> intervals;
+    for (int i = 0; i < MAX_DOCKS; i++) {
+        intervals.clear();
+        getDockCalendar(i, from, to, intervals);
+        *log << "Dock " << docks[i].dockID << ":";
+        for (const CalendarInterval& c : intervals) {
+            *log << " [" << c.start << "-" << c.end << " " << (c.busy ? "Busy" : "Free") << "]";
+        }
+        *log << endl;
+    }
+    *log << "=====================================\n";
+}
+
+static const char* bookingStatus(const Booking& b) {
+    if (b.isActive) return "Active";
+    if (b.isHeld) return "Held";
+    if (b.isExpired) return "Expired";
+    return "Completed";
+}
+
+void ChargingStation::viewUserBookings(int userID) {
+    *log << "\n=== Bookings for User ID: " << userID << " ===\n";
+    bool found = false;
+    for (int i = 0; i < bookingCount; i++) {
+        if (bookings[i].userID == userID) {
+            found = true;
+            *log << "Booking ID: " << bookings[i].bookingID
+                 << ", Vehicle ID: " << bookings[i].vehicleID
+                 << ", Dock ID: " << bookings[i].dockID
+                 << ", Start Time: " << bookings[i].startTime
+                 << ", Duration: " << bookings[i].duration
+                 << ", Status: " << bookingStatus(bookings[i]) << endl;
+        }
+    }
+    if (!found) {
+        *log << "No bookings found for this user." << endl;
+    }
+}
+
+int ChargingStation::findBookingsInRange(float from, float to, vector<int>& out, bool overlapping) const {
+    size_t before = out.size();
+    auto collect = [&out](const IndexEntry& e) { out.push_back(e.bookingIndex); };
+    if (overlapping) {
+        // Preemption can shorten a booking after it was indexed
+        timeIndex.forEachOverlapping(from, to, [this, from, &out](const IndexEntry& e) {
+            const Booking& b = bookings[e.bookingIndex];
+            if (b.startTime + b.duration > from) out.push_back(e.bookingIndex);
+        });
+    } else {
+        timeIndex.forEachStarting(from, to, collect);
+    }
+    return (int)(out.size() - before);
+}
+
+void ChargingStation::viewBookingsInRange(float from, float to) {
+    *log << "\n=== Bookings between " << from << " and " << to << " ===\n";
+    vector<int> found;
+    findBookingsInRange(from, to, found, true);
+    for (int i : found) {
+        *log << "Booking ID: " << bookings[i].bookingID
+             << ", User ID: " << bookings[i].userID
+             << ", Dock ID: " << bookings[i].dockID
+             << ", Start Time: " << bookings[i].startTime
+             << ", Duration: " << bookings[i].duration
+             << ", Status: " << bookingStatus(bookings[i]) << endl;
+    }
+    if (found.empty()) {
+        *log << "No bookings found in this time range." << endl;
+    }
+}
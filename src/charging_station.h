@@ -0,0 +1,407 @@
+#ifndef CHARGING_STATION_H
+#define CHARGING_STATION_H
+
+#include <cmath>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+#include "constants.h"
+#include "energy_source.h"
+#include "user.h"
+#include "ev.h"
+#include "charging_dock.h"
+#include "power_cabinet.h"
+#include "booking.h"
+#include "dock_schedule.h"
+#include "booking_index.h"
+#include "recurring_booking.h"
+#include "hold_timer.h"
+#include "fair_share.h"
+#include "dock_policy.h"
+#include "billing_ledger.h"
+#include "idempotency_table.h"
+#include "power_tree.h"
+
+// Sets of docks are kept as bitmasks, one bit per slot
+static_assert(MAX_DOCKS <= 32, "dock masks hold one bit per dock");
+
+// Charging Station class
+class ChargingStation {
+public:
+    ChargingDock docks[MAX_DOCKS];
+    User users[MAX_USERS];
+    EV vehicles[MAX_USERS];
+    std::vector<Booking> bookings;
+    int userCount;
+    int vehicleCount;
+    int bookingCount;
+    int bookingCapacity;
+    DockSchedule schedules[MAX_DOCKS]; // active reservations per dock
+    BookingTimeIndex timeIndex;        // every booking, ordered by start time
+    float totalOccupiedTime[MAX_DOCKS];
+    float scheduledTime[MAX_DOCKS];  // hours of active bookings per dock
+    int completedSessions[MAX_DOCKS];
+    int dockSlotByID[MAX_DOCK_ID + 1]; // dock ID -> index into docks, -1 if unused
+    unsigned int connectorDocks[CONNECTOR_TYPES]; // docks offering each connector type
+    unsigned int dcDocks;
+    PowerCabinet cabinets[MAX_DOCKS];
+    int cabinetCount;
+    float systemStartTime;
+    std::queue<QueuedBooking> bookingQueues[MEMBERSHIP_TIERS]; // waiting requests per membership tier
+    int stationID;
+    std::ostream* log; // destination for notifications and reports
+    DockPolicy dockPolicy;
+    BillingLedger* billing; // charges and penalties are posted here when set
+    int billingMonth;
+    std::vector<RecurringRule> recurringRules;
+    float recurringHorizon; // hours ahead that recurring occurrences are materialized
+    HoldTimerWheel holdTimers;
+    IdempotencyTable* idempotency; // recent request keys, when set
+    PowerConstraintTree* powerTree; // shared capacity limits, when set
+    int powerNode;                  // this station's site node in powerTree
+    bool preemptionEnabled;
+    FairShareScheduler fairShare; // recent energy served per membership tier
+    bool fairShareEnabled;
+    float phaseLoad[PHASES]; // kW drawn per phase by occupied docks
+    PowerConstraintTree phaseBuckets; // kW booked per time bucket on phase p (node p), while balancing
+    float phaseLimitKW;      // per-phase breaker limit, 0 if none
+    bool phaseBalancing;
+
+    // Disable copy constructor and assignment operator to prevent shallow copy issues
+    ChargingStation(const ChargingStation&) = delete;
+    ChargingStation& operator=(const ChargingStation&) = delete;
+
+    ChargingStation(int sID = 1);
+
+    ~ChargingStation() {}
+
+    // Direct dock ID -> slot lookup
+    int dockSlot(int dockID) const {
+        return (dockID >= 0 && dockID <= MAX_DOCK_ID) ? dockSlotByID[dockID] : -1;
+    }
+
+    void initializeDock(int slot, int id, int rating, EnergySource* source);
+
+    // Group docks as the connectors of one cabinet of powerKW shared between
+    // them. Returns the cabinet index, or -1 if a dock is unknown or already
+    // in a cabinet.
+    int addCabinet(float powerKW, const int* dockIDs, int count);
+
+    // Power a connector can count on over [startTime, endTime): its rating for
+    // a standalone dock, otherwise its share of the cabinet with the other
+    // connectors booked in the interval drawing at the same time
+    float connectorPower(int slot, float startTime, float endTime) const;
+
+    // Set a dock's occupancy and rebalance its cabinet on a change
+    void setOccupied(int slot, bool occupied);
+
+    // Add (sign 1) or remove (sign -1) the phase draw of the occupied docks among slots
+    void applyPhaseDraw(unsigned int slots, float sign);
+
+    // Rewire a dock to the given PHASE_* lines. SLOW AC docks start on a
+    // single phase, rotating L1, L2, L3 by slot; the others on all three.
+    bool setDockPhases(int dockID, unsigned int phases);
+
+    // With balancing on, dock search skips docks that would push a phase past
+    // limitKW (0 for no limit) and, between equally scored docks, takes the one
+    // leaving the phases most even. Booked load is kept per phase in time
+    // buckets while balancing is on, so a search reads it once per phase.
+    void setPhaseBalancing(bool enabled, float limitKW = 0.0f);
+
+    // Highest kW booked on each phase over [startTime, endTime). A booking
+    // counts at the connector power it was reserved with, in every bucket it
+    // touches. Zero while balancing is off.
+    void phaseLoadOver(float startTime, float endTime, float* load) const;
+
+    // Record a reserved booking's draw on its dock's phase buckets, and remove
+    // it again; no-ops while balancing is off
+    void addPhaseLoad(int bookingIndex);
+
+    void removePhaseLoad(int bookingIndex);
+
+    // True if also booking the dock over the interval keeps every phase of
+    // load within the limit; imbalance is then the spread between the most
+    // and least loaded phase
+    bool phaseFits(int slot, float startTime, float endTime, const float* load, float& imbalance) const;
+
+    // Share of a dock's power it can draw, scaled down on overloaded phases
+    float phaseFactor(int slot) const;
+
+    // Raise the booking limit above MAX_BOOKINGS for batch and simulation workloads
+    bool setBookingCapacity(int capacity);
+
+    int findUserIndex(int userID) const;
+
+    int findVehicleIndex(int vehicleID, int userID) const;
+
+    // Docks the vehicle can plug into and draw powerRating from, found with
+    // whole-mask operations over the connector and AC/DC dock sets. preferred
+    // excludes docks rated above what the vehicle can take, so fast docks stay
+    // free for vehicles that can use them.
+    unsigned int compatibleDocks(int vehicleIndex, int powerRating, unsigned int& preferred) const;
+
+    // Dock power as delivered to a vehicle, capped by its acceptance rate;
+    // vehicleIndex -1 gives the dock's own power
+    float effectivePower(int slot, int vehicleIndex) const;
+
+    // kWh delivered over a booking. On a cabinet connector the booking's share
+    // is followed through every change in the other connectors' bookings,
+    // scheduled or completed, so it is the same whatever the completion order.
+    float sessionEnergy(int bookingIndex) const;
+
+    // Record bookings[bookingIndex] on its dock and release it again
+    void reserveDock(int slot, int bookingIndex);
+
+    // As above, inserting at a schedule position the caller already located
+    void reserveDock(int slot, int bookingIndex, int pos);
+
+    void releaseDock(int slot, int bookingIndex);
+
+    // Dock rating a charging type needs: 1 SLOW, 2 MEDIUM, 3 FAST, 4 SOLAR
+    static int powerRatingFor(int chargingType);
+
+    // Book an interval on a dock already known to be free, bypassing dock
+    // search and peak-hour deferral. Returns the booking index, or -1 if the
+    // booking limit is reached or the power tree cannot supply the charging
+    // type's rated power.
+    int placeBooking(int uID, int vID, int slot, float startTime, float duration, int chargingType);
+
+    // Create the next booking on the slot, unchecked, and count its energy
+    // toward the user's fair-share tier. schedulePos is where it goes in the
+    // dock's schedule, -1 to look it up.
+    int admitBooking(int uID, int vID, int slot, float startTime, float duration, int chargingType,
+                     int schedulePos = -1);
+
+    // Post charges and penalties to a shared ledger under the given billing period
+    void attachLedger(BillingLedger* ledger, int month);
+
+    // Deduplicate the keyed operations below through a table, usually shared by the network
+    void attachIdempotencyTable(IdempotencyTable* table);
+
+    // Admit bookings only within the headroom of node and its ancestors.
+    // Bookings already on the dock schedules are recorded on the tree.
+    void attachPowerTree(PowerConstraintTree* tree, int node);
+
+    // Spare capacity over the interval on the power tree, unlimited without one
+    float powerHeadroom(float startTime, float endTime) const;
+
+    // Record a reserved booking's draw on the power tree, capped by the
+    // headroom, and remove it again. The granted kW stays on the booking
+    // for pricing after removal.
+    void addGridLoad(int bookingIndex);
+
+    void removeGridLoad(int bookingIndex);
+
+    // Redirect all station output, e.g. to a null stream for batch simulations
+    void setLog(std::ostream* os);
+
+    void notifyUser(int userID, const std::string& msg, float value = -1.0f);
+
+    bool registerUser(int id, const char* name, int level);
+
+    bool registerVehicle(int vID, int uID, float soc, float capacity, bool v2g);
+
+    bool isCriticalBooking(int uID, int vID);
+
+    // Membership tier of a registered user, 0 if unknown
+    int userTier(int uID) const;
+
+    // Fair-share admission: when enabled, critical bookings skip peak-hour
+    // deferral only while their membership tier is within its energy share.
+    // Queued bookings are always drained most underserved tier first.
+    void setFairShare(bool enabled);
+
+    bool bypassesPeakDeferral(int uID, int vID);
+
+    void queueBooking(const QueuedBooking& qb);
+
+    bool isDockAvailable(int dockID, float startTime, float duration);
+
+    // Scores every suitable dock with Policy and returns the best slot, or -1.
+    // isFree(slot) decides whether the dock is free for the requested interval.
+    template <typename Policy, typename FreeCheck>
+    int selectDock(int powerRating, float startTime, float endTime, bool isSolarCharging, FreeCheck isFree,
+                   unsigned int allowedDocks = ~0u) {
+        float hourOfDay = std::fmod(startTime, (float)HOURS_PER_DAY);
+        bool isPeakHour = (hourOfDay >= PEAK_START && hourOfDay < PEAK_END);
+        if (powerTree != nullptr && powerHeadroom(startTime, endTime) < powerRating) return -1;
+        int bestSlot = -1;
+        float bestScore = 0.0f;
+        float bestImbalance = 0.0f;
+        float intervalLoad[PHASES];
+        if (phaseBalancing) phaseLoadOver(startTime, endTime, intervalLoad);
+
+        for (int i = 0; i < MAX_DOCKS; i++) {
+            if (docks[i].energySource == nullptr || !(allowedDocks & (1u << i))) {
+                continue;
+            }
+            float basePower = (docks[i].cabinet == -1) ? docks[i].powerRating : connectorPower(i, startTime, endTime);
+            float availablePower = docks[i].energySource->getAvailablePower(basePower);
+            bool isSolar = dynamic_cast<SolarPower*>(docks[i].energySource) != nullptr;
+            float imbalance = 0.0f;
+            if (availablePower >= powerRating && (!isSolarCharging || isSolar) &&
+                (!phaseBalancing || phaseFits(i, startTime, endTime, intervalLoad, imbalance)) && isFree(i)) {
+                DockCandidate c;
+                c.index = i;
+                c.availablePower = availablePower;
+                c.isSolar = isSolar;
+                c.co2PerKWh = docks[i].energySource->getCO2Emission(1.0f);
+                c.load = totalOccupiedTime[i] + scheduledTime[i];
+                c.sessions = completedSessions[i];
+                float score = Policy::score(c, powerRating, isPeakHour, isSolarCharging);
+                if (bestSlot == -1 || score < bestScore || (score == bestScore && imbalance < bestImbalance)) {
+                    bestSlot = i;
+                    bestScore = score;
+                    bestImbalance = imbalance;
+                }
+            }
+        }
+        return bestSlot;
+    }
+
+    template <typename Policy>
+    int findAvailableDockWith(int powerRating, float startTime, float duration, bool isSolarCharging, unsigned int allowedDocks) {
+        float endTime = startTime + duration;
+        int slot = selectDock<Policy>(powerRating, startTime, endTime, isSolarCharging,
+            [this, startTime, endTime](int i) { return schedules[i].isFree(startTime, endTime); }, allowedDocks);
+        return (slot == -1) ? -1 : docks[slot].dockID;
+    }
+
+    int findAvailableDock(int powerRating, float startTime, float duration, bool isSolarCharging, unsigned int allowedDocks = ~0u);
+
+    // Dock search for a known vehicle: its preferred docks first, then any compatible one
+    int findVehicleDock(int vehicleIndex, int powerRating, float startTime, float duration, bool isSolarCharging);
+
+    void setDockPolicy(DockPolicy policy);
+
+    float getCurrentPowerConsumption();
+
+    float getPhaseLoad(int phase) const;
+
+    bool createBooking(int uID, int vID, float startTime, float duration, int powerRating, int chargingType);
+
+    // With preemption on, a critical booking (see isCriticalBooking) that finds
+    // no free dock takes one from lower-priority bookings: those starting
+    // earlier are shortened to end when it starts, those starting inside its
+    // interval are moved to another dock, or queued for rebooking if none is free.
+    void setPreemption(bool enabled);
+
+    // Picks the dock whose conflicting bookings are cheapest to displace,
+    // clears the interval on it and returns its ID, or -1. Each dock is checked
+    // with a binary search over its schedule. Displaced bookings to re-place
+    // are appended to bumped.
+    int preemptDock(int powerRating, float startTime, float duration, bool isSolarCharging, std::vector<int>& bumped,
+                    unsigned int allowedDocks = ~0u);
+
+    void replaceBumped(const std::vector<int>& bumped);
+
+    // Two-phase booking. holdBooking reserves a dock for the interval until
+    // now + ttlSeconds and returns the booking ID, or -1. The hold blocks the
+    // dock schedule like a booking but is not billed or listed as active until
+    // confirmHold. Unconfirmed holds are released by expireHolds, which the
+    // hold calls run first. Times passed as now are in seconds.
+    int holdBooking(int uID, int vID, float startTime, float duration, int powerRating, int chargingType,
+                    long long now, int ttlSeconds = DEFAULT_HOLD_TTL);
+
+    bool confirmHold(int bookingID, long long now);
+
+    bool releaseHold(int bookingID);
+
+    // Returns the number of holds released
+    int expireHolds(long long now);
+
+    // Keyed variants of the mutating operations for clients that retry. The
+    // first call with a request key runs the operation and records its result;
+    // a retry with the same key before it expires returns that result without
+    // running again. Each returns the booking ID (create, hold) or 1 on
+    // success, and -1 or 0 on failure, including reuse of a key for another
+    // operation. now is in seconds.
+    int createBookingOnce(unsigned long long requestKey, long long now, int uID, int vID, float startTime,
+                          float duration, int powerRating, int chargingType);
+
+    int cancelBookingOnce(unsigned long long requestKey, long long now, int bookingID);
+
+    int completeBookingOnce(unsigned long long requestKey, long long now, int bookingID);
+
+    int holdBookingOnce(unsigned long long requestKey, long long now, int uID, int vID, float startTime,
+                        float duration, int powerRating, int chargingType, int ttlSeconds = DEFAULT_HOLD_TTL);
+
+    int confirmHoldOnce(unsigned long long requestKey, long long now, int bookingID);
+
+    template <typename Operation>
+    int runOnce(unsigned long long requestKey, long long now, int operation, int failure, Operation run);
+
+    // Admit a batch of requests in one pass. Users and vehicles are resolved
+    // once, requests are sorted by charging type and start time, and dock
+    // availability is checked with one forward sweep over each dock schedule.
+    // Returns the number of accepted bookings; results[i] describes requests[i].
+    int createBookings(const BookingRequest* requests, int count, BookingResult* results);
+
+    template <typename Policy>
+    int createBookingsWith(const BookingRequest* requests, int count, BookingResult* results);
+
+    void cancelBooking(int bookingID);
+
+    // Recurring bookings. A rule repeats every day (RECUR_DAILY) or on the
+    // weekdays in weekdayMask (RECUR_WEEKLY, bit d % 7 for day d) from firstDay
+    // through lastDay (-1 for no end). Returns the rule ID, or -1.
+    int addRecurringBooking(int uID, int vID, float timeOfDay, float duration, int powerRating, int chargingType,
+                            RecurrenceKind kind, int weekdayMask, int firstDay, int lastDay = -1);
+
+    // Skip one day of a rule, releasing the occurrence if already materialized
+    bool addRecurringException(int ruleID, int day);
+
+    // End a rule and release its materialized occurrences starting at or after from
+    bool cancelRecurringBooking(int ruleID, float from);
+
+    // Materialize occurrences starting in [now, now + recurringHorizon) into the
+    // dock schedules. Occurrences that find no free dock are skipped and counted
+    // as conflicts on their rule. Returns the number of bookings created.
+    int expandRecurringBookings(float now);
+
+    void setRecurringHorizon(float hours);
+
+    int expandRule(RecurringRule& rule, float now);
+
+    // Cancel an occurrence of a recurring booking without a penalty
+    void releaseOccurrence(int bookingIndex);
+
+    void processQueue();
+
+    // Price bookings[bookingIndex] without changing any state
+    Invoice priceBooking(int bookingIndex) const;
+
+    void completeBooking(int bookingID);
+
+    // End-of-day settlement: completes every active session ending at or before
+    // endTime. Invoices and SOC gains are computed in parallel chunks, then
+    // applied and appended to the ledger in one pass in booking order.
+    // Returns the number of sessions settled.
+    int settleBookings(float endTime, std::vector<Invoice>& ledger, int threadCount = 1);
+
+    void displayRealTimeData();
+
+    void generateReport();
+
+    void displayDockStatus();
+
+    // Appends the merged busy and free intervals of one dock (by slot) over
+    // [from, to), read straight from its schedule. Returns the number appended.
+    int getDockCalendar(int slot, float from, float to, std::vector<CalendarInterval>& out) const {
+        return schedules[slot].calendar(from, to, out);
+    }
+
+    void displayDockCalendar(float from, float to);
+
+    void viewUserBookings(int userID);
+
+    // Appends to out the indices of bookings starting in [from, to), or with
+    // overlapping set, of bookings whose session overlaps [from, to).
+    // Results are in start-time order. Returns the number found.
+    int findBookingsInRange(float from, float to, std::vector<int>& out, bool overlapping = false) const;
+
+    void viewBookingsInRange(float from, float to);
+};
+
+#endif // CHARGING_STATION_H
@@ -0,0 +1,46 @@
+#ifndef CONSTANTS_H
+#define CONSTANTS_H
+
+// Constants
+const int MAX_USERS = 10;
+const int MAX_DOCKS = 5;
+const int MAX_DOCK_ID = 64; // dock IDs are kept in [1, MAX_DOCK_ID]
+const int MAX_BOOKINGS = 20;
+const int MAX_STATIONS = 3;
+const float GRID_CAPACITY = 150.0;
+
+// Charging dock types
+const int SLOW = 7;
+const int MEDIUM = 22;
+const int FAST = 50;
+const int SOLAR = 7;
+
+// Connector types, as bits of vehicle and dock connector masks
+const unsigned int CONNECTOR_TYPE2 = 1;   // AC
+const unsigned int CONNECTOR_CCS = 2;     // DC
+const unsigned int CONNECTOR_CHADEMO = 4; // DC
+const int CONNECTOR_TYPES = 3;
+const unsigned int ALL_CONNECTORS = (1u << CONNECTOR_TYPES) - 1;
+
+// Supply phases, as bits of a dock's phase mask
+const int PHASES = 3;
+const unsigned int PHASE_L1 = 1;
+const unsigned int PHASE_L2 = 2;
+const unsigned int PHASE_L3 = 4;
+const unsigned int ALL_PHASES = (1u << PHASES) - 1;
+
+// Peak hours
+const float PEAK_START = 12.0;
+const float PEAK_END = 18.0;
+const int HOURS_PER_DAY = 24; // times past the first day are day * HOURS_PER_DAY + hour
+
+// CO2 emission factor for grid energy (kg CO2/kWh)
+const float CO2_GRID_FACTOR = 0.5;
+
+// Weather conditions affecting solar output
+// Thread-local so that simulation shards running on worker threads each see
+// their own weather instead of racing on a shared global.
+enum WeatherCondition { SUNNY, CLOUDY, NIGHT };
+extern thread_local WeatherCondition currentWeather;
+
+#endif // CONSTANTS_H
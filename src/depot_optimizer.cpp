@@ -0,0 +1,144 @@
+#include "depot_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+DepotOptimizer::DepotOptimizer(const vector<Millicents>& ratePerKWh, float gridCapacityKW, float slotHours)
+    : rates(ratePerKWh), gridCapacity(gridCapacityKW), slotLength(slotHours) {
+    rates.resize(HOURS_PER_DAY, rates.empty() ? 0 : rates.back());
+    if (slotLength <= 0.0f) slotLength = 0.25f;
+}
+
+vector<Millicents> DepotOptimizer::standardTariff() {
+    vector<Millicents> tariff(HOURS_PER_DAY, 30000); // Medium, $0.30
+    for (int h = 0; h < HOURS_PER_DAY; h++) {
+        if (h >= PEAK_START && h < PEAK_END) tariff[h] = scalePermille(tariff[h], 1200); // Peak hour surcharge
+    }
+    return tariff;
+}
+
+DepotSchedule DepotOptimizer::optimize(const vector<DepotVehicle>& vehicles, const vector<DepotDock>& docks) const {
+    DepotSchedule result;
+    result.horizonStart = 0.0f;
+    result.slotHours = slotLength;
+    result.totalCostMillicents = 0;
+    result.unmetVehicles = 0;
+    int n = (int)vehicles.size();
+    int dockCount = (int)docks.size();
+    if (n == 0) return result;
+
+    float earliest = vehicles[0].arrivalTime, latest = vehicles[0].departureTime;
+    for (const DepotVehicle& v : vehicles) {
+        earliest = min(earliest, v.arrivalTime);
+        latest = max(latest, v.departureTime);
+    }
+    result.horizonStart = floor(earliest / slotLength) * slotLength;
+    int slots = max(0, (int)ceil((latest - result.horizonStart) / slotLength - 1e-4f));
+    result.siteLoadKW.assign(slots, 0.0f);
+    vector<float>& load = result.siteLoadKW;
+
+    vector<Millicents> slotRate(slots);
+    for (int k = 0; k < slots; k++) {
+        int hour = (int)fmod(result.horizonStart + k * slotLength, (float)HOURS_PER_DAY);
+        slotRate[k] = rates[hour];
+    }
+    vector<char> busy((size_t)dockCount * slots, 0);
+
+    // Energy still needed, and planning order: earliest departure first
+    vector<WattHours> need(n);
+    vector<int> order(n);
+    for (int i = 0; i < n; i++) {
+        const EV& ev = vehicles[i].vehicle;
+        need[i] = kWhToWattHours(max(0.0f, vehicles[i].targetSOC - ev.batterySOC) / 100.0f * ev.batteryCapacity);
+        order[i] = i;
+    }
+    sort(order.begin(), order.end(), [&vehicles, &need](int a, int b) {
+        if (vehicles[a].departureTime != vehicles[b].departureTime) return vehicles[a].departureTime < vehicles[b].departureTime;
+        if (need[a] != need[b]) return need[a] > need[b];
+        return a < b;
+    });
+
+    result.assignments.resize(n);
+    bool costOverflow = false;
+    for (int v : order) {
+        const DepotVehicle& dv = vehicles[v];
+        DepotAssignment& a = result.assignments[v];
+        a.vehicleID = dv.vehicle.vehicleID;
+        a.dockID = -1;
+        a.startTime = a.endTime = dv.arrivalTime;
+        a.energyWh = 0;
+        a.costMillicents = 0;
+        a.targetMet = (need[v] == 0);
+        if (a.targetMet) continue;
+
+        int first = max(0, (int)ceil((dv.arrivalTime - result.horizonStart) / slotLength - 1e-4f));
+        int last = min(slots, (int)floor((dv.departureTime - result.horizonStart) / slotLength + 1e-4f));
+
+        // Try every dock and start slot; a session runs until the target is
+        // reached, the dock is taken or the vehicle leaves
+        int bestDock = -1, bestStart = 0, bestEnd = 0;
+        WattHours bestEnergy = 0;
+        Millicents bestCost = 0;
+        for (int d = 0; d < dockCount; d++) {
+            if (!(docks[d].connectorMask & dv.vehicle.connectorMask)) continue;
+            float dockPower = min(docks[d].powerKW, dv.vehicle.acceptancePower(docks[d].powerKW >= FAST));
+            const char* dockBusy = &busy[(size_t)d * slots];
+            for (int s = first; s < last; s++) {
+                if (dockBusy[s] || min(dockPower, gridCapacity - load[s]) <= 0.0f) continue;
+                WattHours got = 0;
+                Millicents cost = 0;
+                int end = s;
+                for (int k = s; k < last && !dockBusy[k] && got < need[v]; k++) {
+                    float power = min(dockPower, gridCapacity - load[k]);
+                    if (power <= 0.0f) continue;
+                    WattHours wh = min(need[v] - got, kWhToWattHours(power * slotLength));
+                    got += wh;
+                    cost += scalePermille(wh, slotRate[k]);
+                    end = k + 1;
+                }
+                bool met = got >= need[v];
+                bool bestMet = bestDock != -1 && bestEnergy >= need[v];
+                bool better;
+                if (bestDock == -1) better = got > 0;
+                else if (met != bestMet) better = met;
+                else if (met) better = cost < bestCost || (cost == bestCost && end < bestEnd);
+                else better = got > bestEnergy || (got == bestEnergy && cost < bestCost);
+                if (better) {
+                    bestDock = d;
+                    bestStart = s;
+                    bestEnd = end;
+                    bestEnergy = got;
+                    bestCost = cost;
+                }
+            }
+        }
+        if (bestDock == -1) {
+            result.unmetVehicles++;
+            continue;
+        }
+
+        // Commit the session, recording the draw in each slot
+        float dockPower = min(docks[bestDock].powerKW, dv.vehicle.acceptancePower(docks[bestDock].powerKW >= FAST));
+        WattHours got = 0;
+        for (int k = bestStart; k < bestEnd; k++) {
+            busy[(size_t)bestDock * slots + k] = 1;
+            float power = min(dockPower, gridCapacity - load[k]);
+            WattHours wh = (power <= 0.0f) ? 0 : min(need[v] - got, kWhToWattHours(power * slotLength));
+            got += wh;
+            float draw = wattHoursToKWh(wh) / slotLength;
+            load[k] += draw;
+            a.powerKW.push_back(draw);
+        }
+        a.dockID = docks[bestDock].dockID;
+        a.startTime = result.horizonStart + bestStart * slotLength;
+        a.endTime = result.horizonStart + bestEnd * slotLength;
+        a.energyWh = bestEnergy;
+        a.costMillicents = bestCost;
+        a.targetMet = bestEnergy >= need[v];
+        if (!a.targetMet) result.unmetVehicles++;
+        if (!costOverflow && !addChecked(result.totalCostMillicents, bestCost)) costOverflow = true;
+    }
+    if (costOverflow) result.totalCostMillicents = -1;
+    return result;
+}
@@ -0,0 +1,71 @@
+#ifndef DEPOT_OPTIMIZER_H
+#define DEPOT_OPTIMIZER_H
+
+#include <vector>
+#include "constants.h"
+#include "ev.h"
+#include "money.h"
+
+// Vehicle parked at a depot overnight; SOC, capacity, acceptance rates and
+// connectors come from the EV record
+struct DepotVehicle {
+    EV vehicle;
+    float arrivalTime;   // hours, e.g. 19.5
+    float departureTime; // hours, past HOURS_PER_DAY for the next morning
+    float targetSOC;     // percent required at departure
+};
+
+// Docks of FAST rating and above are DC, the others AC
+struct DepotDock {
+    int dockID;
+    float powerKW;
+    unsigned int connectorMask = ALL_CONNECTORS;
+};
+
+// Charging plan for one vehicle. The vehicle holds its dock over
+// [startTime, endTime); powerKW[k] is its draw in the k-th slot of that span.
+struct DepotAssignment {
+    int vehicleID;
+    int dockID;           // -1 if no dock was free at all
+    float startTime;
+    float endTime;
+    std::vector<float> powerKW;
+    WattHours energyWh;
+    Millicents costMillicents;
+    bool targetMet;
+};
+
+struct DepotSchedule {
+    float horizonStart;
+    float slotHours;
+    std::vector<float> siteLoadKW;            // total draw per slot
+    std::vector<DepotAssignment> assignments; // same order as the vehicles
+    Millicents totalCostMillicents;           // -1 if the total overflowed
+    int unmetVehicles;
+};
+
+// Overnight depot charging planner. Time is split into fixed slots; vehicles
+// are planned earliest departure first. Each vehicle takes the dock and the
+// contiguous session inside its parking window that reaches its target at the
+// lowest time-of-use cost, among docks it has a connector for. Its draw in every
+// slot is capped by the dock rating, by what the vehicle accepts from that dock
+// and by the grid capacity left after earlier vehicles, so the site never
+// exceeds the limit. A vehicle that cannot reach its target gets the session
+// delivering the most energy and is reported as unmet.
+class DepotOptimizer {
+public:
+    // ratePerKWh[h]: price in millicents per kWh during hour h of the day
+    DepotOptimizer(const std::vector<Millicents>& ratePerKWh, float gridCapacityKW = GRID_CAPACITY, float slotHours = 0.25f);
+
+    // Grid tariff used by the stations: $0.30/kWh with the peak-hour surcharge
+    static std::vector<Millicents> standardTariff();
+
+    DepotSchedule optimize(const std::vector<DepotVehicle>& vehicles, const std::vector<DepotDock>& docks) const;
+
+private:
+    std::vector<Millicents> rates;
+    float gridCapacity;
+    float slotLength;
+};
+
+#endif // DEPOT_OPTIMIZER_H
@@ -0,0 +1,73 @@
+#ifndef DOCK_POLICY_H
+#define DOCK_POLICY_H
+
+// Dock selection policies. Each policy scores a suitable dock (lower is better,
+// ties go to the lower dock index) and is used as a template parameter so the
+// scoring inlines into the dock search loop.
+enum DockPolicy { POLICY_DEFAULT, POLICY_BEST_FIT, POLICY_LEAST_LOADED, POLICY_SOLAR_FIRST,
+                  POLICY_WEAR_LEVELING, POLICY_CARBON_AWARE };
+
+// Snapshot of a dock that passed the suitability checks
+struct DockCandidate {
+    int index;
+    float availablePower;
+    bool isSolar;
+    float co2PerKWh;
+    float load;     // completed plus scheduled hours
+    int sessions;   // completed sessions
+};
+
+// Original rule: first suitable dock, solar preferred during peak hours
+struct DefaultDockPolicy {
+    static float score(const DockCandidate& c, int, bool isPeakHour, bool isSolarCharging) {
+        return (isPeakHour && !isSolarCharging && c.isSolar) ? 0.0f : 1.0f;
+    }
+};
+
+// Smallest dock that still covers the requested power
+struct BestFitPowerPolicy {
+    static float score(const DockCandidate& c, int powerRating, bool, bool) {
+        return c.availablePower - powerRating;
+    }
+};
+
+// Dock with the fewest completed and scheduled hours
+struct LeastLoadedPolicy {
+    static float score(const DockCandidate& c, int, bool, bool) {
+        return c.load;
+    }
+};
+
+// Solar docks at any hour, then the tightest power fit
+struct SolarFirstPolicy {
+    static float score(const DockCandidate& c, int powerRating, bool, bool) {
+        return (c.isSolar ? 0.0f : 1000.0f) + (c.availablePower - powerRating);
+    }
+};
+
+// Dock with the fewest completed sessions (connector plug cycles)
+struct WearLevelingPolicy {
+    static float score(const DockCandidate& c, int, bool, bool) {
+        return (float)c.sessions;
+    }
+};
+
+// Lowest CO2 per kWh, then the tightest power fit
+struct CarbonAwarePolicy {
+    static float score(const DockCandidate& c, int powerRating, bool, bool) {
+        return c.co2PerKWh * 1000.0f + (c.availablePower - powerRating);
+    }
+};
+
+inline const char* dockPolicyName(DockPolicy policy) {
+    switch (policy) {
+        case POLICY_BEST_FIT: return "Best-Fit Power";
+        case POLICY_LEAST_LOADED: return "Least-Loaded";
+        case POLICY_SOLAR_FIRST: return "Solar-First";
+        case POLICY_WEAR_LEVELING: return "Wear-Leveling";
+        case POLICY_CARBON_AWARE: return "Carbon-Aware";
+        default: return "Default";
+    }
+}
+
+#endif // DOCK_POLICY_H
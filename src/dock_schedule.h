@@ -0,0 +1,119 @@
+#ifndef DOCK_SCHEDULE_H
+#define DOCK_SCHEDULE_H
+
+#include <algorithm>
+#include <vector>
+
+// Reserved interval on a dock, [start, end) in hours
+struct ScheduleEntry {
+    float start;
+    float end;
+    int bookingIndex; // index into ChargingStation::bookings
+};
+
+// Busy or free stretch of a dock calendar, [start, end) in hours
+struct CalendarInterval {
+    float start;
+    float end;
+    bool busy;
+};
+
+// Active reservations of one dock, kept sorted by start time. Entries never
+// overlap, so they are sorted by end time as well. version changes whenever
+// the entries do, so optimistic readers can tell whether a dock was touched.
+class DockSchedule {
+public:
+    std::vector<ScheduleEntry> entries;
+    unsigned long long version;
+
+    DockSchedule() : version(0) {}
+
+    // Position of the first entry starting at or after the given time
+    int lowerBound(float start) const {
+        return (int)(std::lower_bound(entries.begin(), entries.end(), start,
+            [](const ScheduleEntry& e, float t) { return e.start < t; }) - entries.begin());
+    }
+
+    bool isFree(float start, float end) const {
+        int pos = lowerBound(start);
+        if (pos < (int)entries.size() && entries[pos].start < end) return false;
+        if (pos > 0 && entries[pos - 1].end > start) return false;
+        return true;
+    }
+
+    // Earliest start at or after from with the dock free for duration hours
+    float earliestFree(float from, float duration) const {
+        float start = from;
+        int i = lowerBound(from);
+        if (i > 0 && entries[i - 1].end > start) start = entries[i - 1].end;
+        for (; i < (int)entries.size() && entries[i].start < start + duration; i++) {
+            if (entries[i].end > start) start = entries[i].end;
+        }
+        return start;
+    }
+
+    void insert(float start, float end, int bookingIndex) {
+        ScheduleEntry e = { start, end, bookingIndex };
+        entries.insert(entries.begin() + lowerBound(start), e);
+        version++;
+    }
+
+    // Insert at a known position; used by sweeps that already located it
+    void insertAt(int pos, float start, float end, int bookingIndex) {
+        ScheduleEntry e = { start, end, bookingIndex };
+        entries.insert(entries.begin() + pos, e);
+        version++;
+    }
+
+    bool remove(float start, int bookingIndex) {
+        for (int i = lowerBound(start); i < (int)entries.size() && entries[i].start <= start; i++) {
+            if (entries[i].bookingIndex == bookingIndex) {
+                entries.erase(entries.begin() + i);
+                version++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Appends the busy and free intervals covering [from, to), clipped to the
+    // range. Back-to-back reservations are merged into one busy interval.
+    // Returns the number of intervals appended.
+    int calendar(float from, float to, std::vector<CalendarInterval>& out) const {
+        size_t before = out.size();
+        int i = lowerBound(from);
+        if (i > 0 && entries[i - 1].end > from) i--;
+        float cursor = from;
+        for (; i < (int)entries.size() && entries[i].start < to; i++) {
+            float start = std::max(entries[i].start, from);
+            float end = std::min(entries[i].end, to);
+            if (start > cursor) {
+                CalendarInterval gap = { cursor, start, false };
+                out.push_back(gap);
+            }
+            if (out.size() > before && out.back().busy && out.back().end >= start) {
+                out.back().end = end;
+            } else {
+                CalendarInterval busy = { start, end, true };
+                out.push_back(busy);
+            }
+            cursor = end;
+        }
+        if (cursor < to) {
+            CalendarInterval gap = { cursor, to, false };
+            out.push_back(gap);
+        }
+        return (int)(out.size() - before);
+    }
+
+    // Drop the first count entries, e.g. sessions settled at end of day
+    void erasePrefix(int count) {
+        entries.erase(entries.begin(), entries.begin() + count);
+        version++;
+    }
+
+    bool empty() const { return entries.empty(); }
+    int size() const { return (int)entries.size(); }
+};
+
+#endif // DOCK_SCHEDULE_H
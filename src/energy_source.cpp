@@ -0,0 +1,3 @@
+#include "energy_source.h"
+
+thread_local WeatherCondition currentWeather = SUNNY;
@@ -0,0 +1,42 @@
+#ifndef ENERGY_SOURCE_H
+#define ENERGY_SOURCE_H
+
+#include <string>
+#include "constants.h"
+
+// Base class for EnergySource
+class EnergySource {
+public:
+    virtual float getRateAdjustment() const = 0;
+    virtual float getCO2Emission(float energy) const = 0;
+    virtual float getAvailablePower(float basePower) const = 0;
+    virtual std::string getSourceName() const = 0;
+    virtual ~EnergySource() {}
+};
+
+// Derived class for GridPower
+class GridPower : public EnergySource {
+public:
+    float getRateAdjustment() const override { return 1.0; }
+    float getCO2Emission(float energy) const override { return energy * CO2_GRID_FACTOR; }
+    float getAvailablePower(float basePower) const override { return basePower; }
+    std::string getSourceName() const override { return "Grid"; }
+};
+
+// Derived class for SolarPower
+class SolarPower : public EnergySource {
+public:
+    float getRateAdjustment() const override { return 0.9; }
+    float getCO2Emission(float energy) const override { return 0.0; }
+    float getAvailablePower(float basePower) const override {
+        switch (currentWeather) {
+            case SUNNY: return basePower;
+            case CLOUDY: return basePower * 0.5f;
+            case NIGHT: return 0.0f;
+            default: return basePower;
+        }
+    }
+    std::string getSourceName() const override { return "Solar"; }
+};
+
+#endif // ENERGY_SOURCE_H
@@ -0,0 +1,54 @@
+#ifndef EV_H
+#define EV_H
+
+#include <algorithm>
+#include "constants.h"
+
+// Electric Vehicle class
+class EV {
+public:
+    int vehicleID;
+    int userID;
+    float batterySOC;
+    float batteryCapacity;
+    bool supportsV2G;
+    float maxACPowerKW;        // highest rate the on-board charger accepts
+    float maxDCPowerKW;        // highest rate the battery accepts on DC
+    unsigned int connectorMask; // CONNECTOR_* inlets fitted
+
+    EV() : vehicleID(-1), userID(-1), batterySOC(0.0f), batteryCapacity(0.0f), supportsV2G(false),
+           maxACPowerKW(MEDIUM), maxDCPowerKW(FAST), connectorMask(ALL_CONNECTORS) {}
+
+    void registerVehicle(int vID, int uID, float soc, float capacity, bool v2g) {
+        vehicleID = vID;
+        userID = uID;
+        batterySOC = std::max(0.0f, std::min(100.0f, soc));
+        batteryCapacity = std::max(0.0f, capacity);
+        supportsV2G = v2g;
+        maxACPowerKW = MEDIUM;
+        maxDCPowerKW = FAST;
+        connectorMask = ALL_CONNECTORS;
+    }
+
+    void setChargingLimits(float maxAC, float maxDC, unsigned int connectors) {
+        maxACPowerKW = std::max(0.0f, maxAC);
+        maxDCPowerKW = std::max(0.0f, maxDC);
+        connectorMask = connectors & ALL_CONNECTORS;
+    }
+
+    // Power the vehicle can take from a dock of the given kind
+    float acceptancePower(bool isDC) const {
+        return isDC ? maxDCPowerKW : maxACPowerKW;
+    }
+
+    float dischargeToGrid(float energy) {
+        if (!supportsV2G) return 0.0f;
+        float energyAvailable = (batterySOC / 100.0f) * batteryCapacity;
+        float energyToDischarge = std::min(energy, energyAvailable);
+        batterySOC -= (energyToDischarge / batteryCapacity) * 100.0f;
+        if (batterySOC < 0.0f) batterySOC = 0.0f;
+        return energyToDischarge;
+    }
+};
+
+#endif // EV_H
@@ -0,0 +1,71 @@
+#ifndef FAIR_SHARE_H
+#define FAIR_SHARE_H
+
+#include <cmath>
+
+const int MEMBERSHIP_TIERS = 2; // User::membershipLevel: 0 Regular, 1 Premium
+
+// Weighted fair share of charging energy between membership tiers. Served
+// energy is kept per tier as a counter that halves every halfLife hours; a
+// counter is decayed lazily when it is next touched, so recording and
+// checking cost O(tiers) = O(1) and no periodic sweep is needed.
+class FairShareScheduler {
+public:
+    FairShareScheduler(float halfLifeHours = 24.0f) : halfLife(halfLifeHours), clock(0.0f) {
+        for (int t = 0; t < MEMBERSHIP_TIERS; t++) {
+            shares[t] = 1.0f;
+            served[t] = 0.0f;
+            updated[t] = 0.0f;
+        }
+    }
+
+    // Relative weight of a tier; shares are normalized over all tiers
+    void setShare(int tier, float share) {
+        if (tier >= 0 && tier < MEMBERSHIP_TIERS && share > 0.0f) shares[tier] = share;
+    }
+
+    void recordServed(int tier, float energyKWh, float time) {
+        if (tier < 0 || tier >= MEMBERSHIP_TIERS) return;
+        if (time > clock) clock = time;
+        served[tier] = decayed(tier) + energyKWh;
+        updated[tier] = clock;
+    }
+
+    // Served energy per unit of share, as of the latest recorded time
+    float normalizedUsage(int tier) const {
+        return decayed(tier) / shares[tier];
+    }
+
+    // True if the tier has received more than its share of recent energy
+    bool isOverShare(int tier) const {
+        if (tier < 0 || tier >= MEMBERSHIP_TIERS) return false;
+        float totalServed = 0.0f, totalShares = 0.0f;
+        for (int t = 0; t < MEMBERSHIP_TIERS; t++) {
+            totalServed += decayed(t);
+            totalShares += shares[t];
+        }
+        return totalServed > 0.0f && decayed(tier) / totalServed > shares[tier] / totalShares;
+    }
+
+    // Most underserved tier among those with waiting[t] set, or -1
+    int pickTier(const bool* waiting) const {
+        int best = -1;
+        for (int t = 0; t < MEMBERSHIP_TIERS; t++) {
+            if (waiting[t] && (best == -1 || normalizedUsage(t) < normalizedUsage(best))) best = t;
+        }
+        return best;
+    }
+
+private:
+    float decayed(int tier) const {
+        return served[tier] * std::exp2(-(clock - updated[tier]) / halfLife);
+    }
+
+    float halfLife;
+    float clock;     // latest time recorded, hours
+    float shares[MEMBERSHIP_TIERS];
+    float served[MEMBERSHIP_TIERS];  // kWh as of updated[tier]
+    float updated[MEMBERSHIP_TIERS];
+};
+
+#endif // FAIR_SHARE_H
@@ -0,0 +1,52 @@
+#ifndef HOLD_TIMER_H
+#define HOLD_TIMER_H
+
+#include <vector>
+
+const int DEFAULT_HOLD_TTL = 30; // seconds a held slot stays reserved unconfirmed
+
+struct HoldTimer {
+    long long expiry;  // seconds
+    int bookingIndex;  // index into ChargingStation::bookings
+};
+
+// Hashed timer wheel with one-second ticks. Scheduling is O(1); advancing
+// visits each elapsed slot once, and a timer is only touched when its slot
+// comes round, so expiry costs O(1) per hold for TTLs shorter than the wheel.
+// Cancelled timers are not removed; the owner ignores them when they fire.
+class HoldTimerWheel {
+public:
+    static const int WHEEL_SLOTS = 256; // power of two
+
+    HoldTimerWheel() : nextTick(0) {}
+
+    void schedule(long long expiry, int bookingIndex) {
+        HoldTimer t = { expiry, bookingIndex };
+        long long tick = (expiry < nextTick) ? nextTick : expiry;
+        slots[tick & (WHEEL_SLOTS - 1)].push_back(t);
+    }
+
+    // Calls fn(bookingIndex) for every timer with expiry <= now
+    template <typename Fn>
+    void advance(long long now, Fn fn) {
+        if (now < nextTick) return;
+        long long first = nextTick;
+        long long last = (now - nextTick >= WHEEL_SLOTS) ? nextTick + WHEEL_SLOTS - 1 : now;
+        for (long long tick = first; tick <= last; tick++) {
+            std::vector<HoldTimer>& slot = slots[tick & (WHEEL_SLOTS - 1)];
+            size_t kept = 0;
+            for (size_t i = 0; i < slot.size(); i++) {
+                if (slot[i].expiry <= now) fn(slot[i].bookingIndex);
+                else slot[kept++] = slot[i];
+            }
+            slot.resize(kept);
+        }
+        nextTick = now + 1;
+    }
+
+private:
+    std::vector<HoldTimer> slots[WHEEL_SLOTS];
+    long long nextTick; // first tick not yet processed
+};
+
+#endif // HOLD_TIMER_H
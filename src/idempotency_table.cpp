@@ -0,0 +1,105 @@
+#include "idempotency_table.h"
+
+#include <thread>
+using namespace std;
+
+// Table size: power of two with at most 50% load
+static int tableSize(int capacity) {
+    int size = 16;
+    while (size < capacity * 2) size <<= 1;
+    return size;
+}
+
+// Full 64-bit finalizer: client keys are often sequential, and probing is
+// limited to a short window
+static unsigned int hashKey(unsigned long long k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return (unsigned int)k;
+}
+
+IdempotencyTable::IdempotencyTable(int capacity, long long ttlSeconds) : ttlSeconds(ttlSeconds) {
+    int size = tableSize(capacity);
+    mask = size - 1;
+    slots.reset(new Slot[size]);
+    for (int i = 0; i < size; i++) {
+        Slot& s = slots[i];
+        s.version.store(0, memory_order_relaxed);
+        s.key.store(0, memory_order_relaxed);
+        s.expiry.store(0, memory_order_relaxed);
+        s.stationID.store(0, memory_order_relaxed);
+        s.operation.store(0, memory_order_relaxed);
+        s.value.store(0, memory_order_relaxed);
+    }
+}
+
+bool IdempotencyTable::lookup(unsigned long long key, long long now, IdempotentResult& result) const {
+    if (key == 0) return false;
+    unsigned int home = hashKey(key);
+    for (int probe = 0; probe < MAX_PROBE; probe++) {
+        const Slot& s = slots[(home + probe) & mask];
+        unsigned long long k;
+        long long expiry;
+        IdempotentResult r;
+        while (true) {
+            unsigned int before = s.version.load(memory_order_acquire);
+            if (before & 1) {
+                this_thread::yield();
+                continue;
+            }
+            // Acquire loads pair with the writer's release stores: a word
+            // from a newer write makes its odd version visible to the
+            // recheck. No fences, which ThreadSanitizer cannot model.
+            k = s.key.load(memory_order_acquire);
+            expiry = s.expiry.load(memory_order_acquire);
+            r.stationID = s.stationID.load(memory_order_acquire);
+            r.operation = s.operation.load(memory_order_acquire);
+            r.value = s.value.load(memory_order_acquire);
+            if (s.version.load(memory_order_acquire) == before) break;
+        }
+        if (k == 0) return false;
+        if (k == key) {
+            if (expiry <= now) return false;
+            result = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+void IdempotencyTable::record(unsigned long long key, long long now, const IdempotentResult& result) {
+    if (key == 0) return;
+    lock_guard<mutex> lock(writeMutex);
+    unsigned int home = hashKey(key);
+
+    // Reuse the key's own slot, else the first empty or expired one, else
+    // evict the entry that expires first
+    Slot* target = nullptr;
+    Slot* reusable = nullptr;
+    Slot* oldest = nullptr;
+    for (int probe = 0; probe < MAX_PROBE; probe++) {
+        Slot& s = slots[(home + probe) & mask];
+        unsigned long long k = s.key.load(memory_order_relaxed);
+        long long expiry = s.expiry.load(memory_order_relaxed);
+        if (k == key) {
+            target = &s;
+            break;
+        }
+        if (reusable == nullptr && (k == 0 || expiry <= now)) reusable = &s;
+        if (k == 0) break;
+        if (oldest == nullptr || expiry < oldest->expiry.load(memory_order_relaxed)) oldest = &s;
+    }
+    if (target == nullptr) target = (reusable != nullptr) ? reusable : oldest;
+
+    unsigned int version = target->version.load(memory_order_relaxed);
+    target->version.store(version + 1, memory_order_release);
+    target->key.store(key, memory_order_release);
+    target->expiry.store(now + ttlSeconds, memory_order_release);
+    target->stationID.store(result.stationID, memory_order_release);
+    target->operation.store(result.operation, memory_order_release);
+    target->value.store(result.value, memory_order_release);
+    target->version.store(version + 2, memory_order_release);
+}
@@ -0,0 +1,57 @@
+#ifndef IDEMPOTENCY_TABLE_H
+#define IDEMPOTENCY_TABLE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+// Station operations that can be retried under a request key
+enum IdempotentOperation { OP_CREATE_BOOKING = 1, OP_CANCEL_BOOKING, OP_COMPLETE_BOOKING, OP_HOLD_BOOKING, OP_CONFIRM_HOLD };
+
+// Outcome of the first call made with a request key
+struct IdempotentResult {
+    int stationID;
+    int operation; // IdempotentOperation
+    int value;     // booking ID, or 1/0 for success/failure
+};
+
+// Bounded table of recent request keys and their results, shared by the
+// stations of a network. Entries expire ttlSeconds after they are recorded.
+// Lookups are lock-free: each slot is a sequence lock, so a reader retries
+// the rare read that overlaps a write instead of blocking. Writers are
+// serialized by a mutex. Keys are probed within a fixed window; when the
+// window is full of live keys the one expiring first is evicted.
+class IdempotencyTable {
+public:
+    static const int MAX_PROBE = 16;
+
+    IdempotencyTable(int capacity, long long ttlSeconds);
+
+    // Disable copy constructor and assignment operator; the table owns atomics
+    IdempotencyTable(const IdempotencyTable&) = delete;
+    IdempotencyTable& operator=(const IdempotencyTable&) = delete;
+
+    // Key 0 is never recorded
+    bool lookup(unsigned long long key, long long now, IdempotentResult& result) const;
+
+    void record(unsigned long long key, long long now, const IdempotentResult& result);
+
+    long long ttl() const { return ttlSeconds; }
+
+private:
+    struct Slot {
+        std::atomic<unsigned int> version; // odd while a writer updates the slot
+        std::atomic<unsigned long long> key; // 0 when empty
+        std::atomic<long long> expiry;
+        std::atomic<int> stationID;
+        std::atomic<int> operation;
+        std::atomic<int> value;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    int mask;
+    long long ttlSeconds;
+    std::mutex writeMutex;
+};
+
+#endif // IDEMPOTENCY_TABLE_H
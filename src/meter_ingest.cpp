@@ -0,0 +1,153 @@
+#include "meter_ingest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+static const double MS_PER_HOUR = 3600000.0;
+
+MeterRing::MeterRing(int capacity) : head(0), tail(0) {
+    unsigned long long size = 16;
+    while (size < (unsigned long long)capacity) size <<= 1;
+    buffer.reset(new MeterReading[size]);
+    mask = size - 1;
+}
+
+MeterIngestor::MeterIngestor(ChargingStation& s, int ringCapacity) : station(s), rejectedReadings(0), history(nullptr) {
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        historySeries[d] = -1;
+        rings[d].reset(new MeterRing(ringCapacity));
+        DockMeter& m = meters[d];
+        m.lastMs = -1;
+        m.lastPowerKW = 0.0f;
+        m.lastRegisterWh = -1;
+        m.bookingIndex = -1;
+        m.sessionWh = 0.0;
+        m.scheduleVersion = 0;
+        m.entryStartMs = m.entryEndMs = 0.0;
+        m.entryBooking = -1;
+    }
+}
+
+void MeterIngestor::recordTo(TimeSeriesStore* store) {
+    history = store;
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        historySeries[d] = (store == nullptr) ? -1 : store->seriesFor(station.stationID, station.docks[d].dockID);
+    }
+}
+
+bool MeterIngestor::push(const MeterReading& r) {
+    int slot = station.dockSlot(r.dockID);
+    return slot != -1 && rings[slot]->push(r);
+}
+
+int MeterIngestor::process() {
+    int n = 0;
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        n += rings[d]->drain([this, d](const MeterReading& r) { integrate(d, r); });
+    }
+    return n;
+}
+
+double MeterIngestor::segmentWh(const DockMeter& m, const MeterReading& r, double from, double to,
+                                double sessionStart, double sessionEnd) const {
+    bool lastInside = m.lastMs != -1 && m.lastMs >= sessionStart;
+    bool nextInside = r.timestampMs <= sessionEnd;
+    if (lastInside && nextInside && r.registerWh >= 0 && m.lastRegisterWh >= 0) {
+        return (double)(r.registerWh - m.lastRegisterWh);
+    }
+    // Outside the session the dock is idle, so the reading on the session's
+    // side is held up to the session boundary instead of interpolated
+    float fromKW = lastInside ? m.lastPowerKW : r.powerKW;
+    float toKW = nextInside ? r.powerKW : m.lastPowerKW;
+    return (fromKW + toKW) * 500.0 * (to - from) / MS_PER_HOUR;
+}
+
+void MeterIngestor::addEnergy(DockMeter& m, int bookingIndex, double wh) {
+    if (wh <= 0.0) return;
+    Booking& b = station.bookings[bookingIndex];
+    if (bookingIndex != m.bookingIndex) {
+        m.bookingIndex = bookingIndex;
+        m.sessionWh = (b.measuredWh > 0) ? (double)b.measuredWh : 0.0;
+    }
+    m.sessionWh += wh;
+    b.measuredWh = llround(m.sessionWh);
+}
+
+void MeterIngestor::integrate(int slot, const MeterReading& r) {
+    DockMeter& m = meters[slot];
+    if (r.timestampMs <= m.lastMs) {
+        rejectedReadings++;
+        return;
+    }
+    const DockSchedule& schedule = station.schedules[slot];
+    double now = (double)r.timestampMs;
+    if (m.lastMs != -1 && m.entryBooking != -1 && m.scheduleVersion == schedule.version &&
+        m.lastMs >= m.entryStartMs && now <= m.entryEndMs) {
+        // Both readings inside the cached session
+        addEnergy(m, m.entryBooking, segmentWh(m, r, (double)m.lastMs, now, m.entryStartMs, m.entryEndMs));
+    } else {
+        // Clamp the interval since the previous reading to each session it
+        // overlaps. A dock's first reading covers its session from the start.
+        double last = (m.lastMs == -1) ? now : (double)m.lastMs;
+        float lastHour = (float)(last / MS_PER_HOUR);
+        int k = schedule.lowerBound(lastHour);
+        if (k > 0 && schedule.entries[k - 1].end >= lastHour) k--;
+        m.entryBooking = -1;
+        for (; k < (int)schedule.entries.size() && schedule.entries[k].start * MS_PER_HOUR < now; k++) {
+            const ScheduleEntry& e = schedule.entries[k];
+            double start = e.start * MS_PER_HOUR, end = e.end * MS_PER_HOUR;
+            if (end < last) continue;
+            double from = (m.lastMs == -1) ? start : max(last, start);
+            double to = min(now, end);
+            addEnergy(m, e.bookingIndex, segmentWh(m, r, from, to, start, end));
+            if (now <= end) {
+                m.scheduleVersion = schedule.version;
+                m.entryStartMs = start;
+                m.entryEndMs = end;
+                m.entryBooking = e.bookingIndex;
+            }
+        }
+    }
+    if (history != nullptr) history->append(historySeries[slot], r.timestampMs, r.powerKW);
+    m.lastMs = r.timestampMs;
+    m.lastPowerKW = r.powerKW;
+    m.lastRegisterWh = r.registerWh;
+}
+
+int MeterIngestor::ingestFile(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) return -1;
+    char line[256];
+    int accepted = 0;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        char* p = line;
+        char* next;
+        MeterReading r;
+        r.dockID = (int)strtol(p, &next, 10);
+        if (next == p) continue;
+        p = next;
+        r.timestampMs = strtoll(p, &next, 10);
+        if (next == p) continue;
+        p = next;
+        r.powerKW = strtof(p, &next);
+        if (next == p) continue;
+        p = next;
+        r.registerWh = strtoll(p, &next, 10);
+        if (next == p) r.registerWh = -1;
+
+        if (!push(r)) {
+            process();
+            if (!push(r)) {
+                rejectedReadings++;
+                continue;
+            }
+        }
+        accepted++;
+    }
+    fclose(file);
+    process();
+    return accepted;
+}
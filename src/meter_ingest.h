@@ -0,0 +1,115 @@
+#ifndef METER_INGEST_H
+#define METER_INGEST_H
+
+#include <atomic>
+#include <memory>
+#include "charging_station.h"
+#include "time_series_store.h"
+
+// Meter value reported by a dock. Timestamps are milliseconds on the station
+// clock (hour h of the bookings is h * 3600000).
+struct MeterReading {
+    int dockID;
+    long long timestampMs;
+    float powerKW;
+    long long registerWh; // cumulative energy register, -1 if not reported
+};
+
+// Bounded single-producer single-consumer queue. The producer only writes
+// tail and the consumer only writes head, so neither side takes a lock.
+class MeterRing {
+public:
+    explicit MeterRing(int capacity = 4096);
+
+    // Disable copy constructor and assignment operator; the ring owns atomics
+    MeterRing(const MeterRing&) = delete;
+    MeterRing& operator=(const MeterRing&) = delete;
+
+    // Producer side; false if the ring is full
+    bool push(const MeterReading& r) {
+        unsigned long long t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) > mask) return false;
+        buffer[t & mask] = r;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: passes every queued reading to fn and returns the count
+    template <typename Fn>
+    int drain(Fn fn) {
+        unsigned long long h = head.load(std::memory_order_relaxed);
+        unsigned long long t = tail.load(std::memory_order_acquire);
+        for (unsigned long long i = h; i < t; i++) fn(buffer[i & mask]);
+        head.store(t, std::memory_order_release);
+        return (int)(t - h);
+    }
+
+private:
+    std::unique_ptr<MeterReading[]> buffer;
+    unsigned long long mask;
+    alignas(64) std::atomic<unsigned long long> head;
+    alignas(64) std::atomic<unsigned long long> tail;
+};
+
+// Meter feed for one station, with a ring per dock. A feed thread (one per
+// dock at most) pushes readings; the thread that owns the station calls
+// process, which integrates each dock's readings into the bookings on it.
+// Consecutive readings inside a session add the difference of their energy
+// registers, or the trapezoid of their power when a register is missing. An
+// interval crossing a session's start or end is clamped to the session, with
+// the reading inside it held to the boundary. The total is kept in
+// Booking::measuredWh and billed instead of power x duration. Readings
+// arriving out of order are counted and dropped.
+class MeterIngestor {
+public:
+    MeterIngestor(ChargingStation& station, int ringCapacity = 4096);
+
+    // Lock-free; false if the dock is unknown or its ring is full
+    bool push(const MeterReading& r);
+
+    // Integrate everything queued; returns the number of readings consumed
+    int process();
+
+    // Read "dockID timestampMs powerKW [registerWh]" lines from a file,
+    // processing whenever a ring fills. Returns the readings accepted, or -1
+    // if the file cannot be opened.
+    int ingestFile(const char* path);
+
+    long long rejected() const { return rejectedReadings; }
+
+    // Also append every accepted reading's power to the dock's series in store
+    void recordTo(TimeSeriesStore* store);
+
+private:
+    // Last reading and open session of a dock
+    struct DockMeter {
+        long long lastMs;        // -1 before the first reading
+        float lastPowerKW;
+        long long lastRegisterWh;
+        int bookingIndex;        // session being integrated, -1 if none
+        double sessionWh;
+        unsigned long long scheduleVersion; // schedule state the cached entry came from
+        double entryStartMs;
+        double entryEndMs;
+        int entryBooking;        // cached entry of the latest reading's session, -1 if none
+    };
+
+    // Energy over [from, to] ms, part of the interval between the dock's
+    // previous reading and r, for a session covering [sessionStart, sessionEnd]
+    double segmentWh(const DockMeter& m, const MeterReading& r, double from, double to,
+                     double sessionStart, double sessionEnd) const;
+
+    // Add to a booking's measured energy, rounding only the running total
+    void addEnergy(DockMeter& m, int bookingIndex, double wh);
+
+    void integrate(int slot, const MeterReading& r);
+
+    ChargingStation& station;
+    std::unique_ptr<MeterRing> rings[MAX_DOCKS];
+    DockMeter meters[MAX_DOCKS];
+    long long rejectedReadings;
+    TimeSeriesStore* history;
+    int historySeries[MAX_DOCKS];
+};
+
+#endif // METER_INGEST_H
@@ -0,0 +1,44 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cmath>
+
+// Billing units. Money is kept in millicents (1/1000 of a cent) and energy in
+// watt-hours, so costs and totals are exact integers that do not drift and sum
+// to the same value in any order.
+typedef long long Millicents;
+typedef long long WattHours;
+
+const Millicents MILLICENTS_PER_DOLLAR = 100000;
+const long long PERMILLE = 1000;
+
+inline WattHours kWhToWattHours(float kWh) {
+    return (WattHours)std::llround((double)kWh * 1000.0);
+}
+
+inline float wattHoursToKWh(WattHours wh) {
+    return (float)wh / 1000.0f;
+}
+
+inline double millicentsToDollars(Millicents amount) {
+    return (double)amount / MILLICENTS_PER_DOLLAR;
+}
+
+// Scale a non-negative amount by a factor given in thousandths, rounding half up
+inline long long scalePermille(long long value, long long permille) {
+    return (value * permille + PERMILLE / 2) / PERMILLE;
+}
+
+inline long long toPermille(float factor) {
+    return (long long)std::llround((double)factor * PERMILLE);
+}
+
+// Adds value to total; returns false and leaves total unchanged on overflow
+inline bool addChecked(long long& total, long long value) {
+    long long result;
+    if (__builtin_add_overflow(total, value, &result)) return false;
+    total = result;
+    return true;
+}
+
+#endif // MONEY_H
@@ -0,0 +1,58 @@
+#ifndef POWER_CABINET_H
+#define POWER_CABINET_H
+
+#include <algorithm>
+#include "charging_dock.h"
+
+// Power cabinet feeding several connectors, each of them a dock of the
+// station. Connectors are referenced by dock slot, as bits of a mask. The
+// connectors in use split the cabinet's power: each gets an equal share capped
+// at its own rating, and the share a lower-rated connector cannot use goes to
+// the others.
+class PowerCabinet {
+public:
+    float powerKW;
+    unsigned int connectors; // dock slots fed by this cabinet
+
+    PowerCabinet() : powerKW(0.0f), connectors(0) {}
+
+    // Power level per connector while the connectors in active draw at once;
+    // a connector gets min(its rating, level). Water-filling: connectors rated
+    // below the level keep their rating and the rest is split again among the
+    // others, until none is capped. At most one pass per connector, no allocation.
+    float shareLevel(unsigned int active, const ChargingDock* docks) const {
+        unsigned int uncapped = active & connectors;
+        if (uncapped == 0) return powerKW;
+        float remaining = powerKW;
+        float level = remaining / __builtin_popcount(uncapped);
+        for (;;) {
+            unsigned int capped = 0;
+            for (unsigned int rest = uncapped; rest != 0; rest &= rest - 1) {
+                int i = __builtin_ctz(rest);
+                if (docks[i].powerRating < level) {
+                    capped |= 1u << i;
+                    remaining -= docks[i].powerRating;
+                }
+            }
+            if (capped == 0 || capped == uncapped) return level;
+            uncapped &= ~capped;
+            level = remaining / __builtin_popcount(uncapped);
+        }
+    }
+
+    // Recompute every connector's allocation after a plug-in or unplug
+    void rebalance(ChargingDock* docks) const {
+        unsigned int active = 0;
+        for (unsigned int rest = connectors; rest != 0; rest &= rest - 1) {
+            int i = __builtin_ctz(rest);
+            if (docks[i].isOccupied) active |= 1u << i;
+        }
+        float level = shareLevel(active, docks);
+        for (unsigned int rest = connectors; rest != 0; rest &= rest - 1) {
+            int i = __builtin_ctz(rest);
+            docks[i].allocatedKW = (active & (1u << i)) ? std::min((float)docks[i].powerRating, level) : 0.0f;
+        }
+    }
+};
+
+#endif // POWER_CABINET_H
@@ -0,0 +1,74 @@
+#include "power_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+using namespace std;
+
+PowerConstraintTree::PowerConstraintTree(float horizonHours, float bucketHours) : bucketLength(bucketHours) {
+    if (bucketLength <= 0.0f) bucketLength = 0.25f;
+    buckets = max(1, (int)ceil(horizonHours / bucketLength));
+    size = 1;
+    while (size < buckets) size <<= 1;
+}
+
+int PowerConstraintTree::addNode(int parent, float capacityKW) {
+    if (parent < -1 || parent >= (int)nodes.size()) return -1;
+    Node n;
+    n.parent = parent;
+    n.capacity = capacityKW;
+    n.peak.assign(2 * size, 0.0f);
+    n.pending.assign(2 * size, 0.0f);
+    nodes.push_back(n);
+    return (int)nodes.size() - 1;
+}
+
+bool PowerConstraintTree::bucketRange(float startTime, float endTime, int& first, int& last) const {
+    first = max(0, (int)floor(startTime / bucketLength));
+    last = min(buckets, (int)ceil(endTime / bucketLength));
+    return first < last;
+}
+
+void PowerConstraintTree::add(Node& n, int i, int lo, int hi, int first, int last, float powerKW) {
+    if (last <= lo || hi <= first) return;
+    if (first <= lo && hi <= last) {
+        n.peak[i] += powerKW;
+        n.pending[i] += powerKW;
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    add(n, 2 * i, lo, mid, first, last, powerKW);
+    add(n, 2 * i + 1, mid, hi, first, last, powerKW);
+    n.peak[i] = max(n.peak[2 * i], n.peak[2 * i + 1]) + n.pending[i];
+}
+
+float PowerConstraintTree::query(const Node& n, int i, int lo, int hi, int first, int last) const {
+    if (last <= lo || hi <= first) return -numeric_limits<float>::max();
+    if (first <= lo && hi <= last) return n.peak[i];
+    int mid = (lo + hi) / 2;
+    return max(query(n, 2 * i, lo, mid, first, last), query(n, 2 * i + 1, mid, hi, first, last)) + n.pending[i];
+}
+
+float PowerConstraintTree::headroom(int node, float startTime, float endTime) const {
+    float spare = numeric_limits<float>::max();
+    int first, last;
+    if (!bucketRange(startTime, endTime, first, last)) return spare;
+    for (int k = node; k >= 0 && k < (int)nodes.size(); k = nodes[k].parent) {
+        spare = min(spare, nodes[k].capacity - query(nodes[k], 1, 0, size, first, last));
+    }
+    return spare;
+}
+
+void PowerConstraintTree::addLoad(int node, float startTime, float endTime, float powerKW) {
+    int first, last;
+    if (!bucketRange(startTime, endTime, first, last)) return;
+    for (int k = node; k >= 0 && k < (int)nodes.size(); k = nodes[k].parent) {
+        add(nodes[k], 1, 0, size, first, last, powerKW);
+    }
+}
+
+float PowerConstraintTree::peakLoad(int node, float startTime, float endTime) const {
+    int first, last;
+    if (node < 0 || node >= (int)nodes.size() || !bucketRange(startTime, endTime, first, last)) return 0.0f;
+    return query(nodes[node], 1, 0, size, first, last);
+}
@@ -0,0 +1,54 @@
+#ifndef POWER_TREE_H
+#define POWER_TREE_H
+
+#include <vector>
+#include "constants.h"
+
+// Tree of shared capacity limits, e.g. substation -> feeder -> site, with
+// stations attached to site nodes. Each node keeps the load booked on it per
+// time bucket in a segment tree whose range adds stay pending at the covering
+// nodes (lazy propagation), so checking or recording a session at a node and
+// all of its ancestors costs O(depth x log buckets). A session is counted for
+// every bucket it touches; time outside [0, horizon) is not tracked.
+class PowerConstraintTree {
+public:
+    PowerConstraintTree(float horizonHours = 14.0f * HOURS_PER_DAY, float bucketHours = 0.25f);
+
+    // Returns the new node's ID, or -1 if parent does not exist. Roots have parent -1.
+    int addNode(int parent, float capacityKW);
+
+    int nodeCount() const { return (int)nodes.size(); }
+
+    // Smallest spare capacity over [startTime, endTime) on the path from node
+    // up to its root
+    float headroom(int node, float startTime, float endTime) const;
+
+    bool fits(int node, float startTime, float endTime, float powerKW) const {
+        return headroom(node, startTime, endTime) >= powerKW;
+    }
+
+    // Record powerKW on node and every ancestor; a negative power removes it
+    void addLoad(int node, float startTime, float endTime, float powerKW);
+
+    // Highest load booked on the node over [startTime, endTime)
+    float peakLoad(int node, float startTime, float endTime) const;
+
+private:
+    struct Node {
+        int parent;
+        float capacity;
+        std::vector<float> peak;    // max load in the range, including this node's pending add
+        std::vector<float> pending; // add applied to the whole range, not pushed to children
+    };
+
+    bool bucketRange(float startTime, float endTime, int& first, int& last) const;
+    void add(Node& n, int i, int lo, int hi, int first, int last, float powerKW);
+    float query(const Node& n, int i, int lo, int hi, int first, int last) const;
+
+    std::vector<Node> nodes;
+    float bucketLength;
+    int buckets;
+    int size; // leaves of each segment tree, a power of two
+};
+
+#endif // POWER_TREE_H
@@ -0,0 +1,48 @@
+#ifndef RECURRING_BOOKING_H
+#define RECURRING_BOOKING_H
+
+#include <algorithm>
+#include <vector>
+#include "constants.h"
+
+enum RecurrenceKind { RECUR_DAILY, RECUR_WEEKLY };
+
+const int ALL_WEEKDAYS = 0x7F; // bit d % 7 set for every day d
+
+// Rule for a booking that repeats every day or on selected weekdays.
+// Occurrence d starts at d * HOURS_PER_DAY + timeOfDay. Only the rule is kept;
+// ChargingStation materializes occurrences into the dock schedules as they
+// come within its rolling horizon.
+struct RecurringRule {
+    int ruleID;
+    int userID;
+    int vehicleID;
+    float timeOfDay;        // after peak-hour deferral
+    float duration;
+    int powerRating;
+    int chargingType;
+    int weekdayMask;        // ALL_WEEKDAYS for daily rules
+    int firstDay;
+    int lastDay;            // inclusive, -1 for no end
+    int nextDay;            // first day not yet materialized
+    int conflicts;          // occurrences skipped because no dock was free
+    bool isActive;
+    std::vector<int> exceptions; // sorted days to skip
+
+    bool occursOn(int day) const {
+        if (day < firstDay || (lastDay != -1 && day > lastDay)) return false;
+        if (!(weekdayMask & (1 << (day % 7)))) return false;
+        return !std::binary_search(exceptions.begin(), exceptions.end(), day);
+    }
+
+    float startOn(int day) const {
+        return (float)day * HOURS_PER_DAY + timeOfDay;
+    }
+
+    void addException(int day) {
+        std::vector<int>::iterator it = std::lower_bound(exceptions.begin(), exceptions.end(), day);
+        if (it == exceptions.end() || *it != day) exceptions.insert(it, day);
+    }
+};
+
+#endif // RECURRING_BOOKING_H
@@ -0,0 +1,212 @@
+#include "simulation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+using namespace std;
+
+SimEvent SimulationShard::makeEvent(float time, int type, int target) {
+    SimEvent e;
+    e.time = time;
+    e.sourceShard = shardID;
+    e.sequence = nextSequence++;
+    e.type = type;
+    e.targetShard = target;
+    e.userID = -1;
+    e.vehicleID = -1;
+    e.duration = 0.0f;
+    e.powerRating = 0;
+    e.chargingType = 0;
+    e.bookingID = -1;
+    e.hops = 0;
+    return e;
+}
+
+void SimulationShard::generateArrivals(int count) {
+    static const int ratings[4] = { SLOW, MEDIUM, FAST, SOLAR };
+    for (int i = 0; i < count; i++) {
+        SimEvent e = makeEvent(simUniform(rng) * 24.0f, SIM_ARRIVAL, shardID);
+        int user = (int)(simUniform(rng) * MAX_USERS);
+        e.userID = user + 1;
+        e.vehicleID = user + 101;
+        e.duration = 0.5f + simUniform(rng) * 2.5f;
+        e.chargingType = 1 + (int)(simUniform(rng) * 4);
+        e.powerRating = ratings[e.chargingType - 1];
+        pending.push_back(e);
+    }
+    sort(pending.begin(), pending.end());
+}
+
+void SimulationShard::advance(float barrierTime, float travelTime) {
+    currentWeather = weather;
+    size_t processed = 0;
+    vector<SimEvent> completions;
+    while (processed < pending.size() && pending[processed].time < barrierTime) {
+        const SimEvent e = pending[processed++];
+        clock = e.time;
+        if (e.type == SIM_COMPLETION) {
+            station->completeBooking(e.bookingID);
+            completed++;
+            continue;
+        }
+        if (station->createBooking(e.userID, e.vehicleID, e.time, e.duration, e.powerRating, e.chargingType)) {
+            const Booking& b = station->bookings[station->bookingCount - 1];
+            SimEvent done = makeEvent(b.startTime + b.duration, SIM_COMPLETION, shardID);
+            done.bookingID = b.bookingID;
+            completions.push_back(done);
+            accepted++;
+        } else if (e.hops < shardCount - 1) {
+            // Send the driver to the next station; arrives no earlier than the next barrier
+            SimEvent moved = e;
+            moved.time = e.time + travelTime;
+            moved.sourceShard = shardID;
+            moved.sequence = nextSequence++;
+            moved.targetShard = (shardID + 1) % shardCount;
+            moved.hops = e.hops + 1;
+            outbox.push_back(moved);
+            redirected++;
+        } else {
+            dropped++;
+        }
+    }
+    pending.erase(pending.begin(), pending.begin() + processed);
+    if (!completions.empty()) {
+        pending.insert(pending.end(), completions.begin(), completions.end());
+        sort(pending.begin(), pending.end());
+    }
+    clock = barrierTime;
+}
+
+uint64_t SimulationShard::digest() const {
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            h ^= (v >> (i * 8)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+    };
+    auto mixFloat = [&mix](float f) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        mix(bits);
+    };
+    for (int i = 0; i < station->bookingCount; i++) {
+        const Booking& b = station->bookings[i];
+        mix((uint32_t)b.bookingID);
+        mix((uint32_t)b.userID);
+        mix((uint32_t)b.dockID);
+        mixFloat(b.startTime);
+        mixFloat(b.duration);
+        mix((uint32_t)b.costMillicents);
+        mix((uint32_t)(b.costMillicents >> 32));
+        mix((uint32_t)b.energyWh);
+        mix((uint32_t)(b.energyWh >> 32));
+    }
+    return h;
+}
+DeterministicSimulator::DeterministicSimulator(ChargingNetwork& net, uint64_t seed, float epoch)
+    : network(net), epochLength(epoch), nullStream(nullptr) {
+    seed_seq seq{ (uint32_t)seed, (uint32_t)(seed >> 32) };
+    vector<uint32_t> shardSeeds(MAX_STATIONS * 2);
+    seq.generate(shardSeeds.begin(), shardSeeds.end());
+
+    // Members are registered identically at every station so that redirected
+    // drivers are recognised; their attributes come from the network seed
+    mt19937_64 memberRng(seed);
+    float socs[MAX_USERS], capacities[MAX_USERS];
+    int levels[MAX_USERS];
+    for (int u = 0; u < MAX_USERS; u++) {
+        levels[u] = simUniform(memberRng) < 0.3f ? 1 : 0;
+        socs[u] = simUniform(memberRng) * 100.0f;
+        capacities[u] = 40.0f + simUniform(memberRng) * 60.0f;
+    }
+
+    for (int i = 0; i < MAX_STATIONS; i++) {
+        ChargingStation& cs = *network.stations[i];
+        cs.setLog(&nullStream);
+        for (int u = 0; u < MAX_USERS; u++) {
+            char name[16];
+            snprintf(name, sizeof(name), "sim-%d", u + 1);
+            cs.registerUser(u + 1, name, levels[u]);
+            cs.registerVehicle(u + 101, u + 1, socs[u], capacities[u], false);
+        }
+        uint64_t shardSeed = ((uint64_t)shardSeeds[2 * i] << 32) | shardSeeds[2 * i + 1];
+        shards.emplace_back(i, &cs, shardSeed, MAX_STATIONS);
+    }
+}
+
+DeterministicSimulator::~DeterministicSimulator() {
+    for (int i = 0; i < MAX_STATIONS; i++) network.stations[i]->setLog(&cout);
+}
+
+void DeterministicSimulator::run(int arrivalsPerShard, int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+    for (SimulationShard& s : shards) s.generateArrivals(arrivalsPerShard);
+
+    float barrier = 0.0f;
+    while (true) {
+        bool work = false;
+        for (const SimulationShard& s : shards) {
+            if (!s.pending.empty()) work = true;
+        }
+        if (!work) break;
+        barrier += epochLength;
+
+        // Weather for the epoch is drawn from each shard's own RNG
+        for (SimulationShard& s : shards) {
+            float w = simUniform(s.rng);
+            s.weather = (barrier > 20.0f || barrier <= 6.0f) ? NIGHT : (w < 0.7f ? SUNNY : CLOUDY);
+        }
+
+        if (threadCount == 1) {
+            for (SimulationShard& s : shards) s.advance(barrier, epochLength);
+        }
+        vector<thread> workers;
+        for (int t = 0; threadCount > 1 && t < threadCount; t++) {
+            workers.emplace_back([this, t, threadCount, barrier]() {
+                for (size_t i = t; i < shards.size(); i += threadCount) {
+                    shards[i].advance(barrier, epochLength);
+                }
+            });
+        }
+        for (thread& w : workers) w.join();
+
+        // Barrier: merge cross-shard events in timestamp order
+        vector<SimEvent> exchanged;
+        for (SimulationShard& s : shards) {
+            exchanged.insert(exchanged.end(), s.outbox.begin(), s.outbox.end());
+            s.outbox.clear();
+        }
+        sort(exchanged.begin(), exchanged.end());
+        for (const SimEvent& e : exchanged) {
+            shards[e.targetShard].pending.push_back(e);
+        }
+        for (SimulationShard& s : shards) {
+            sort(s.pending.begin(), s.pending.end());
+        }
+    }
+}
+
+uint64_t DeterministicSimulator::digest() const {
+    uint64_t h = 1469598103934665603ULL;
+    for (const SimulationShard& s : shards) {
+        h ^= s.digest();
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void DeterministicSimulator::printSummary(ostream& os) const {
+    os << "\n=== Deterministic Simulation Summary ===\n";
+    os << left << setw(10) << "Station" << setw(12) << "Accepted" << setw(12) << "Redirected"
+       << setw(10) << "Dropped" << setw(12) << "Completed" << "Digest" << endl;
+    os << string(74, '-') << endl;
+    for (const SimulationShard& s : shards) {
+        os << left << setw(10) << s.station->stationID << setw(12) << s.accepted << setw(12) << s.redirected
+           << setw(10) << s.dropped << setw(12) << s.completed << hex << s.digest() << dec << endl;
+    }
+    os << "Run Digest: " << hex << digest() << dec << endl;
+    os << "=====================================\n";
+}
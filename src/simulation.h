@@ -0,0 +1,97 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "charging_network.h"
+
+// Simulation event types
+enum SimEventType { SIM_ARRIVAL, SIM_COMPLETION };
+
+// Event processed by a simulation shard. Events are ordered by
+// (time, sourceShard, sequence) so that every run replays them identically.
+struct SimEvent {
+    float time;
+    int sourceShard;
+    long long sequence;
+    int type;
+    int targetShard;
+    int userID;
+    int vehicleID;
+    float duration;
+    int powerRating;
+    int chargingType;
+    int bookingID;
+    int hops;
+
+    bool operator<(const SimEvent& other) const {
+        if (time != other.time) return time < other.time;
+        if (sourceShard != other.sourceShard) return sourceShard < other.sourceShard;
+        return sequence < other.sequence;
+    }
+};
+
+// Uniform float in [0, 1) built from raw generator bits so the sequence does not
+// depend on the standard library's distribution implementation
+inline float simUniform(std::mt19937_64& rng) {
+    return (float)(rng() >> 40) * (1.0f / 16777216.0f);
+}
+
+// One station shard: owns a station, its RNG, its logical clock and its weather
+class SimulationShard {
+public:
+    int shardID;
+    ChargingStation* station;
+    std::mt19937_64 rng;
+    float clock;
+    WeatherCondition weather;
+    std::vector<SimEvent> pending;  // sorted, not yet processed
+    std::vector<SimEvent> outbox;   // events for other shards, exchanged at the barrier
+    long long nextSequence;
+    int shardCount;
+    int accepted;
+    int redirected;
+    int dropped;
+    int completed;
+
+    SimulationShard(int id, ChargingStation* cs, uint64_t seed, int shards)
+        : shardID(id), station(cs), rng(seed), clock(0.0f), weather(SUNNY), nextSequence(0),
+          shardCount(shards), accepted(0), redirected(0), dropped(0), completed(0) {}
+
+    SimEvent makeEvent(float time, int type, int target);
+
+    // Generate this shard's arrivals for one day from its own RNG
+    void generateArrivals(int count);
+
+    // Process every pending event earlier than barrierTime
+    void advance(float barrierTime, float travelTime);
+
+    // FNV-1a digest over the shard's booking records
+    uint64_t digest() const;
+};
+
+// Deterministic parallel simulation over the stations of a network.
+// Shards advance independently between barriers; cross-shard events are merged
+// in (time, sourceShard, sequence) order at each barrier, so the outcome is
+// identical for any thread count.
+class DeterministicSimulator {
+public:
+    ChargingNetwork& network;
+    std::vector<SimulationShard> shards;
+    float epochLength;
+    std::ostream nullStream;
+
+    DeterministicSimulator(ChargingNetwork& net, uint64_t seed, float epoch = 1.0f);
+
+    ~DeterministicSimulator();
+
+    void run(int arrivalsPerShard, int threadCount);
+
+    uint64_t digest() const;
+
+    void printSummary(std::ostream& os) const;
+};
+
+#endif // SIMULATION_H
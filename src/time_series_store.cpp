@@ -0,0 +1,305 @@
+#include "time_series_store.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+using namespace std;
+
+static const long long MAX_CHUNK_DELTA = 1LL << 30; // ms; keeps every delta-of-delta within 32 bits
+
+// Append the low n bits of v (1 <= n <= 64) to a bit stream
+static void putBits(vector<uint64_t>& words, uint64_t& bitCount, uint64_t v, int n) {
+    if (n < 64) v &= (1ULL << n) - 1;
+    int used = (int)(bitCount & 63);
+    if (used == 0) words.push_back(0);
+    int room = 64 - used;
+    if (n <= room) {
+        words.back() |= v << (room - n);
+    } else {
+        words.back() |= v >> (n - room);
+        words.push_back(v << (64 - (n - room)));
+    }
+    bitCount += n;
+}
+
+namespace {
+
+struct BitReader {
+    const uint64_t* words;
+    uint64_t pos;
+
+    bool bit() {
+        bool b = (words[pos >> 6] >> (63 - (pos & 63))) & 1;
+        pos++;
+        return b;
+    }
+
+    uint64_t get(int n) {
+        uint64_t i = pos >> 6;
+        int offset = (int)(pos & 63);
+        pos += n;
+        uint64_t hi = words[i] << offset;
+        if (offset + n <= 64) return hi >> (64 - n);
+        return (hi | (words[i + 1] >> (64 - offset))) >> (64 - n);
+    }
+};
+
+} // namespace
+
+static uint32_t floatBits(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static float bitsFloat(uint32_t bits) {
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+template <typename Fn>
+void TimeSeriesStore::decode(const Chunk& c, Fn fn) {
+    BitReader in = { c.words.data(), 0 };
+    long long ts = c.firstMs, delta = 0;
+    uint32_t bits = (uint32_t)in.get(32);
+    int leading = 0, trailing = 0;
+    fn(ts, bitsFloat(bits));
+    for (int k = 1; k < c.count; k++) {
+        long long dod;
+        if (!in.bit()) dod = 0;
+        else if (!in.bit()) dod = (long long)in.get(7) - 63;
+        else if (!in.bit()) dod = (long long)in.get(9) - 255;
+        else if (!in.bit()) dod = (long long)in.get(12) - 2047;
+        else dod = (int32_t)(uint32_t)in.get(32);
+        delta += dod;
+        ts += delta;
+
+        if (in.bit()) {
+            if (in.bit()) {
+                leading = (int)in.get(5);
+                int length = (int)in.get(5) + 1;
+                trailing = 32 - leading - length;
+            }
+            bits ^= (uint32_t)in.get(32 - leading - trailing) << trailing;
+        }
+        fn(ts, bitsFloat(bits));
+    }
+}
+
+int TimeSeriesStore::seriesFor(int stationID, int dockID) {
+    pair<int, int> key(stationID, dockID);
+    map<pair<int, int>, int>::iterator it = seriesIndex.find(key);
+    if (it != seriesIndex.end()) return it->second;
+    Series s;
+    s.stationID = stationID;
+    s.dockID = dockID;
+    s.open = false;
+    s.prevMs = s.prevDelta = 0;
+    s.prevBits = 0;
+    s.prevLeading = s.prevTrailing = 0;
+    series.push_back(s);
+    seriesIndex[key] = (int)series.size() - 1;
+    return (int)series.size() - 1;
+}
+
+bool TimeSeriesStore::append(int id, long long timestampMs, float value) {
+    if (id < 0 || id >= (int)series.size()) return false;
+    Series& s = series[id];
+    if (!s.chunks.empty() && timestampMs <= s.chunks.back().lastMs) return false;
+    if (s.open && (s.chunks.back().count >= CHUNK_SAMPLES || timestampMs - s.prevMs > MAX_CHUNK_DELTA)) s.open = false;
+
+    uint32_t bits = floatBits(value);
+    if (!s.open) {
+        Chunk c;
+        c.firstMs = c.lastMs = timestampMs;
+        c.count = 1;
+        c.minValue = c.maxValue = value;
+        c.sum = value;
+        c.bitCount = 0;
+        putBits(c.words, c.bitCount, bits, 32);
+        s.chunks.push_back(c);
+        s.open = true;
+        s.prevMs = timestampMs;
+        s.prevDelta = 0;
+        s.prevBits = bits;
+        s.prevLeading = -1; // no XOR window yet
+        s.prevTrailing = 0;
+        return true;
+    }
+
+    Chunk& c = s.chunks.back();
+    long long delta = timestampMs - s.prevMs;
+    long long dod = delta - s.prevDelta;
+    if (dod == 0) putBits(c.words, c.bitCount, 0, 1);
+    else if (dod >= -63 && dod <= 64) putBits(c.words, c.bitCount, (0x2ULL << 7) | (uint64_t)(dod + 63), 9);
+    else if (dod >= -255 && dod <= 256) putBits(c.words, c.bitCount, (0x6ULL << 9) | (uint64_t)(dod + 255), 12);
+    else if (dod >= -2047 && dod <= 2048) putBits(c.words, c.bitCount, (0xEULL << 12) | (uint64_t)(dod + 2047), 16);
+    else putBits(c.words, c.bitCount, (0xFULL << 32) | (uint32_t)(int32_t)dod, 36);
+
+    uint32_t x = bits ^ s.prevBits;
+    if (x == 0) {
+        putBits(c.words, c.bitCount, 0, 1);
+    } else {
+        int leading = min(__builtin_clz(x), 31);
+        int trailing = __builtin_ctz(x);
+        if (s.prevLeading >= 0 && leading >= s.prevLeading && trailing >= s.prevTrailing) {
+            int length = 32 - s.prevLeading - s.prevTrailing;
+            putBits(c.words, c.bitCount, 0x2, 2);
+            putBits(c.words, c.bitCount, x >> s.prevTrailing, length);
+        } else {
+            int length = 32 - leading - trailing;
+            putBits(c.words, c.bitCount, (0x3ULL << 10) | ((uint64_t)leading << 5) | (uint64_t)(length - 1), 12);
+            putBits(c.words, c.bitCount, x >> trailing, length);
+            s.prevLeading = leading;
+            s.prevTrailing = trailing;
+        }
+    }
+
+    c.lastMs = timestampMs;
+    c.count++;
+    c.minValue = min(c.minValue, value);
+    c.maxValue = max(c.maxValue, value);
+    c.sum += value;
+    s.prevMs = timestampMs;
+    s.prevDelta = delta;
+    s.prevBits = bits;
+    return true;
+}
+
+void TimeSeriesStore::read(int id, long long fromMs, long long toMs, vector<SeriesSample>& out) const {
+    if (id < 0 || id >= (int)series.size()) return;
+    const vector<Chunk>& chunks = series[id].chunks;
+    vector<Chunk>::const_iterator it = lower_bound(chunks.begin(), chunks.end(), fromMs,
+        [](const Chunk& c, long long t) { return c.lastMs < t; });
+    for (; it != chunks.end() && it->firstMs < toMs; ++it) {
+        decode(*it, [&out, fromMs, toMs](long long ts, float v) {
+            if (ts >= fromMs && ts < toMs) out.push_back(SeriesSample{ ts, v });
+        });
+    }
+}
+
+long long TimeSeriesStore::scan(int id, long long fromMs, long long toMs, long long bucketMs, vector<SeriesBucket>& out) const {
+    out.clear();
+    if (id < 0 || id >= (int)series.size() || bucketMs <= 0 || toMs <= fromMs) return 0;
+    long long buckets = (toMs - fromMs + bucketMs - 1) / bucketMs;
+    out.resize(buckets);
+    for (long long b = 0; b < buckets; b++) {
+        SeriesBucket& sb = out[b];
+        sb.startMs = fromMs + b * bucketMs;
+        sb.count = 0;
+        sb.minValue = sb.maxValue = 0.0f;
+        sb.sum = 0.0;
+    }
+    long long samples = 0;
+    auto merge = [&out, &samples](long long b, int count, float lo, float hi, double sum) {
+        SeriesBucket& sb = out[b];
+        if (sb.count == 0) {
+            sb.minValue = lo;
+            sb.maxValue = hi;
+        } else {
+            sb.minValue = min(sb.minValue, lo);
+            sb.maxValue = max(sb.maxValue, hi);
+        }
+        sb.count += count;
+        sb.sum += sum;
+        samples += count;
+    };
+
+    const vector<Chunk>& chunks = series[id].chunks;
+    vector<Chunk>::const_iterator it = lower_bound(chunks.begin(), chunks.end(), fromMs,
+        [](const Chunk& c, long long t) { return c.lastMs < t; });
+    for (; it != chunks.end() && it->firstMs < toMs; ++it) {
+        const Chunk& c = *it;
+        if (c.firstMs >= fromMs && c.lastMs < toMs && (c.firstMs - fromMs) / bucketMs == (c.lastMs - fromMs) / bucketMs) {
+            merge((c.firstMs - fromMs) / bucketMs, c.count, c.minValue, c.maxValue, c.sum);
+            continue;
+        }
+        decode(c, [&merge, fromMs, toMs, bucketMs](long long ts, float v) {
+            if (ts >= fromMs && ts < toMs) merge((ts - fromMs) / bucketMs, 1, v, v, v);
+        });
+    }
+    return samples;
+}
+
+long long TimeSeriesStore::sampleCount() const {
+    long long n = 0;
+    for (const Series& s : series) {
+        for (const Chunk& c : s.chunks) n += c.count;
+    }
+    return n;
+}
+
+long long TimeSeriesStore::compressedBytes() const {
+    long long bytes = 0;
+    for (const Series& s : series) {
+        for (const Chunk& c : s.chunks) bytes += (long long)((c.bitCount + 7) / 8) + sizeof(Chunk);
+    }
+    return bytes;
+}
+
+static const char STORE_MAGIC[8] = { 'E', 'V', 'T', 'S', '0', '0', '0', '1' };
+
+bool TimeSeriesStore::save(const char* path) const {
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr) return false;
+    bool ok = fwrite(STORE_MAGIC, sizeof(STORE_MAGIC), 1, f) == 1;
+    int n = (int)series.size();
+    ok = ok && fwrite(&n, sizeof(n), 1, f) == 1;
+    for (int i = 0; ok && i < n; i++) {
+        const Series& s = series[i];
+        int chunkCount = (int)s.chunks.size();
+        ok = fwrite(&s.stationID, sizeof(int), 1, f) == 1 && fwrite(&s.dockID, sizeof(int), 1, f) == 1 &&
+             fwrite(&chunkCount, sizeof(int), 1, f) == 1;
+        for (int k = 0; ok && k < chunkCount; k++) {
+            const Chunk& c = s.chunks[k];
+            ok = fwrite(&c.firstMs, sizeof(c.firstMs), 1, f) == 1 && fwrite(&c.lastMs, sizeof(c.lastMs), 1, f) == 1 &&
+                 fwrite(&c.count, sizeof(c.count), 1, f) == 1 && fwrite(&c.minValue, sizeof(c.minValue), 1, f) == 1 &&
+                 fwrite(&c.maxValue, sizeof(c.maxValue), 1, f) == 1 && fwrite(&c.sum, sizeof(c.sum), 1, f) == 1 &&
+                 fwrite(&c.bitCount, sizeof(c.bitCount), 1, f) == 1 &&
+                 fwrite(c.words.data(), sizeof(uint64_t), c.words.size(), f) == c.words.size();
+        }
+    }
+    return fclose(f) == 0 && ok;
+}
+
+bool TimeSeriesStore::load(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (f == nullptr) return false;
+    char magic[sizeof(STORE_MAGIC)];
+    int n = 0;
+    bool ok = fread(magic, sizeof(magic), 1, f) == 1 && memcmp(magic, STORE_MAGIC, sizeof(magic)) == 0 &&
+              fread(&n, sizeof(n), 1, f) == 1 && n >= 0;
+    vector<Series> loaded;
+    map<pair<int, int>, int> index;
+    for (int i = 0; ok && i < n; i++) {
+        Series s;
+        int chunkCount = 0;
+        ok = fread(&s.stationID, sizeof(int), 1, f) == 1 && fread(&s.dockID, sizeof(int), 1, f) == 1 &&
+             fread(&chunkCount, sizeof(int), 1, f) == 1 && chunkCount >= 0;
+        s.open = false;
+        s.prevMs = s.prevDelta = 0;
+        s.prevBits = 0;
+        s.prevLeading = s.prevTrailing = 0;
+        for (int k = 0; ok && k < chunkCount; k++) {
+            Chunk c;
+            ok = fread(&c.firstMs, sizeof(c.firstMs), 1, f) == 1 && fread(&c.lastMs, sizeof(c.lastMs), 1, f) == 1 &&
+                 fread(&c.count, sizeof(c.count), 1, f) == 1 && fread(&c.minValue, sizeof(c.minValue), 1, f) == 1 &&
+                 fread(&c.maxValue, sizeof(c.maxValue), 1, f) == 1 && fread(&c.sum, sizeof(c.sum), 1, f) == 1 &&
+                 fread(&c.bitCount, sizeof(c.bitCount), 1, f) == 1 && c.count > 0 && c.count <= CHUNK_SAMPLES &&
+                 c.bitCount <= (uint64_t)c.count * 80;
+            if (!ok) break;
+            size_t stored = (size_t)((c.bitCount + 63) / 64);
+            c.words.resize(stored);
+            ok = fread(c.words.data(), sizeof(uint64_t), stored, f) == stored;
+            s.chunks.push_back(c);
+        }
+        index[make_pair(s.stationID, s.dockID)] = i;
+        loaded.push_back(s);
+    }
+    fclose(f);
+    if (!ok) return false;
+    series.swap(loaded);
+    seriesIndex.swap(index);
+    return true;
+}
@@ -0,0 +1,92 @@
+#ifndef TIME_SERIES_STORE_H
+#define TIME_SERIES_STORE_H
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+struct SeriesSample {
+    long long timestampMs;
+    float value;
+};
+
+// Aggregate of the samples in [startMs, startMs + bucket length)
+struct SeriesBucket {
+    long long startMs;
+    int count;
+    float minValue;
+    float maxValue;
+    double sum;
+};
+
+// Compressed power history, one series per station dock. Samples are cut
+// into chunks of up to CHUNK_SAMPLES; within a chunk, timestamps are stored
+// as delta-of-delta codes and values as the XOR with the previous value
+// (Gorilla encoding), so a dock reporting at a steady rate with slowly
+// changing power costs one or two bytes per sample. Each chunk keeps its
+// time range, count, min, max and sum, which lets downsampled scans take a
+// whole chunk from its summary when it falls inside one bucket and decode
+// only the chunks that straddle bucket edges.
+class TimeSeriesStore {
+public:
+    static const int CHUNK_SAMPLES = 4096;
+
+    TimeSeriesStore() {}
+
+    // Series handle for a dock, created on first use
+    int seriesFor(int stationID, int dockID);
+
+    // Samples must arrive in increasing time order per series; returns false otherwise
+    bool append(int series, long long timestampMs, float value);
+
+    // Raw samples in [fromMs, toMs), appended to out
+    void read(int series, long long fromMs, long long toMs, std::vector<SeriesSample>& out) const;
+
+    // Buckets of bucketMs from fromMs up to toMs; out is resized to the bucket
+    // count and empty buckets have count 0. Returns the number of samples.
+    long long scan(int series, long long fromMs, long long toMs, long long bucketMs, std::vector<SeriesBucket>& out) const;
+
+    int seriesCount() const { return (int)series.size(); }
+    long long sampleCount() const;
+    long long compressedBytes() const;
+
+    // Snapshot of every series to a file and back. After load, appends
+    // start new chunks.
+    bool save(const char* path) const;
+    bool load(const char* path);
+
+private:
+    struct Chunk {
+        long long firstMs;
+        long long lastMs;
+        int count;
+        float minValue;
+        float maxValue;
+        double sum;
+        std::vector<uint64_t> words; // bit stream, most significant bit first
+        uint64_t bitCount;
+    };
+
+    struct Series {
+        int stationID;
+        int dockID;
+        std::vector<Chunk> chunks;
+        // Encoder state of the last chunk, valid while open
+        bool open;
+        long long prevMs;
+        long long prevDelta;
+        uint32_t prevBits;
+        int prevLeading;
+        int prevTrailing;
+    };
+
+    // Calls fn(timestamp, value) for every sample of the chunk
+    template <typename Fn>
+    static void decode(const Chunk& c, Fn fn);
+
+    std::vector<Series> series;
+    std::map<std::pair<int, int>, int> seriesIndex; // (station, dock) -> series
+};
+
+#endif // TIME_SERIES_STORE_H
@@ -0,0 +1,189 @@
+#include "trip_planner.h"
+
+#include <algorithm>
+using namespace std;
+
+static int chargingTypeFor(const ChargingDock& dock) {
+    if (dynamic_cast<SolarPower*>(dock.energySource) != nullptr) return 4;
+    if (dock.powerRating >= FAST) return 3;
+    if (dock.powerRating >= MEDIUM) return 2;
+    return 1;
+}
+
+static ChargingStation* stationByID(ChargingNetwork& network, int stationID) {
+    return (stationID >= 1 && stationID <= MAX_STATIONS) ? network.stations[stationID - 1] : nullptr;
+}
+
+static const EV* tripVehicle(ChargingNetwork& network, const TripRequest& request) {
+    for (int s = 0; s < MAX_STATIONS; s++) {
+        const ChargingStation* station = network.stations[s];
+        if (station == nullptr || station->findUserIndex(request.userID) == -1) continue;
+        int v = station->findVehicleIndex(request.vehicleID, request.userID);
+        if (v != -1) return &station->vehicles[v];
+    }
+    return nullptr;
+}
+
+void TripPlanner::prune(vector<int>& front) const {
+    sort(front.begin(), front.end(), [this](int a, int b) {
+        if (labels[a].time != labels[b].time) return labels[a].time < labels[b].time;
+        return labels[a].soc > labels[b].soc;
+    });
+    size_t kept = 0;
+    for (size_t i = 0; i < front.size(); i++) {
+        if (kept == 0 || labels[front[i]].soc > labels[front[kept - 1]].soc) front[kept++] = front[i];
+    }
+    front.resize(kept);
+}
+
+bool TripPlanner::plan(const TripRequest& request, TripPlan& result) {
+    labels.clear();
+    result.legs.clear();
+    const EV* ev = tripVehicle(network, request);
+    if (ev == nullptr || ev->batteryCapacity <= 0.0f || request.consumptionKWhPerKm < 0.0f || request.speedKmh <= 0.0f) {
+        return false;
+    }
+    float capacity = ev->batteryCapacity;
+    float socPerKm = request.consumptionKWhPerKm / capacity * 100.0f;
+
+    Label departure = Label();
+    departure.time = request.departureTime;
+    departure.soc = ev->batterySOC;
+    departure.parent = -1;
+    departure.hasLeg = false;
+    labels.push_back(departure);
+    vector<int> front(1, 0), next;
+
+    for (const TripStop& stop : request.route) {
+        ChargingStation* station = stationByID(network, stop.stationID);
+        float driveTime = stop.distanceKm / request.speedKmh;
+        float driveSOC = stop.distanceKm * socPerKm;
+        next.clear();
+        for (int l : front) {
+            float arrival = labels[l].time + driveTime;
+            float soc = labels[l].soc - driveSOC;
+            if (soc < request.reserveSOC) continue;
+
+            // Drive on without charging
+            Label pass = Label();
+            pass.time = arrival;
+            pass.soc = soc;
+            pass.parent = l;
+            pass.hasLeg = false;
+            labels.push_back(pass);
+            next.push_back((int)labels.size() - 1);
+            if (station == nullptr) continue;
+
+            // Charge to each SOC target on each dock the vehicle can use, in
+            // its first free window and at the power the vehicle accepts
+            int vehicle = station->findVehicleIndex(request.vehicleID, request.userID);
+            unsigned int preferred;
+            unsigned int usable = (vehicle == -1) ? ~0u : station->compatibleDocks(vehicle, 0, preferred);
+            for (int d = 0; d < MAX_DOCKS; d++) {
+                const ChargingDock& dock = station->docks[d];
+                if (dock.energySource == nullptr || !(usable & (1u << d))) continue;
+                float power = station->effectivePower(d, vehicle);
+                if (power <= 0.0f) continue;
+                for (int target = ((int)soc / SOC_STEP + 1) * SOC_STEP; target <= 100; target += SOC_STEP) {
+                    float duration = (target - soc) / 100.0f * capacity / power;
+                    float start = station->schedules[d].earliestFree(arrival, duration);
+                    if (station->powerHeadroom(start, start + duration) < ChargingStation::powerRatingFor(chargingTypeFor(dock))) {
+                        continue;
+                    }
+                    Label charged = Label();
+                    charged.time = start + duration;
+                    charged.soc = (float)target;
+                    charged.parent = l;
+                    charged.hasLeg = true;
+                    charged.leg.stationID = stop.stationID;
+                    charged.leg.dockSlot = d;
+                    charged.leg.dockID = dock.dockID;
+                    charged.leg.chargingType = chargingTypeFor(dock);
+                    charged.leg.arrivalTime = arrival;
+                    charged.leg.startTime = start;
+                    charged.leg.duration = duration;
+                    charged.leg.arrivalSOC = soc;
+                    charged.leg.departureSOC = (float)target;
+                    charged.leg.bookingID = -1;
+                    labels.push_back(charged);
+                    next.push_back((int)labels.size() - 1);
+                }
+            }
+        }
+        prune(next);
+        front.swap(next);
+    }
+
+    // Last drive to the destination
+    int best = -1;
+    float bestTime = 0.0f, bestSOC = 0.0f;
+    for (int l : front) {
+        float soc = labels[l].soc - request.finalDistanceKm * socPerKm;
+        float time = labels[l].time + request.finalDistanceKm / request.speedKmh;
+        if (soc < request.reserveSOC) continue;
+        if (best == -1 || time < bestTime || (time == bestTime && soc > bestSOC)) {
+            best = l;
+            bestTime = time;
+            bestSOC = soc;
+        }
+    }
+    if (best == -1) return false;
+
+    for (int l = best; l != -1; l = labels[l].parent) {
+        if (labels[l].hasLeg) result.legs.push_back(labels[l].leg);
+    }
+    reverse(result.legs.begin(), result.legs.end());
+    result.arrivalTime = bestTime;
+    result.arrivalSOC = bestSOC;
+    return true;
+}
+
+bool TripPlanner::legsFitPowerTree(const TripRequest& request, const TripPlan& plan) {
+    // Each leg is checked with the earlier ones drawing their most, then
+    // their load is taken off the tree again
+    size_t loaded = 0;
+    for (; loaded < plan.legs.size(); loaded++) {
+        const TripLeg& leg = plan.legs[loaded];
+        ChargingStation* station = network.stations[leg.stationID - 1];
+        float end = leg.startTime + leg.duration;
+        if (station->powerHeadroom(leg.startTime, end) < ChargingStation::powerRatingFor(leg.chargingType)) break;
+        if (station->powerTree == nullptr) continue;
+        float draw = station->effectivePower(leg.dockSlot, station->findVehicleIndex(request.vehicleID, request.userID));
+        station->powerTree->addLoad(station->powerNode, leg.startTime, end, draw);
+    }
+    for (size_t k = 0; k < loaded; k++) {
+        const TripLeg& leg = plan.legs[k];
+        ChargingStation* station = network.stations[leg.stationID - 1];
+        if (station->powerTree == nullptr) continue;
+        float draw = station->effectivePower(leg.dockSlot, station->findVehicleIndex(request.vehicleID, request.userID));
+        station->powerTree->addLoad(station->powerNode, leg.startTime, leg.startTime + leg.duration, -draw);
+    }
+    return loaded == plan.legs.size();
+}
+
+bool TripPlanner::book(const TripRequest& request, TripPlan& plan) {
+    // Check every leg before placing any
+    int needed[MAX_STATIONS] = { 0 };
+    for (const TripLeg& leg : plan.legs) {
+        ChargingStation* station = stationByID(network, leg.stationID);
+        if (station == nullptr || station->findUserIndex(request.userID) == -1 ||
+            station->findVehicleIndex(request.vehicleID, request.userID) == -1) {
+            return false;
+        }
+        if (!station->schedules[leg.dockSlot].isFree(leg.startTime, leg.startTime + leg.duration)) return false;
+        needed[leg.stationID - 1]++;
+    }
+    for (int s = 0; s < MAX_STATIONS; s++) {
+        if (network.stations[s]->bookingCount + needed[s] > network.stations[s]->bookingCapacity) return false;
+    }
+    if (!legsFitPowerTree(request, plan)) return false;
+
+    for (TripLeg& leg : plan.legs) {
+        ChargingStation* station = network.stations[leg.stationID - 1];
+        int index = station->placeBooking(request.userID, request.vehicleID, leg.dockSlot, leg.startTime, leg.duration,
+                                          leg.chargingType);
+        leg.bookingID = station->bookings[index].bookingID;
+        station->notifyUser(request.userID, "Trip charging stop scheduled at:", leg.startTime);
+    }
+    return true;
+}
@@ -0,0 +1,86 @@
+#ifndef TRIP_PLANNER_H
+#define TRIP_PLANNER_H
+
+#include <vector>
+#include "charging_network.h"
+
+// Candidate charging stop on a route
+struct TripStop {
+    int stationID;
+    float distanceKm; // from the previous stop, or from the origin for the first one
+};
+
+// Battery capacity and SOC at departure come from the vehicle's EV record
+struct TripRequest {
+    int userID;
+    int vehicleID;
+    float departureTime;       // hours
+    float consumptionKWhPerKm;
+    float speedKmh;
+    float reserveSOC;          // percent that must remain on arrival anywhere
+    std::vector<TripStop> route;
+    float finalDistanceKm;     // from the last stop to the destination
+};
+
+// One charging session of a plan
+struct TripLeg {
+    int stationID;
+    int dockSlot;
+    int dockID;
+    int chargingType;
+    float arrivalTime;
+    float startTime;   // later than arrivalTime when waiting for the dock
+    float duration;
+    float arrivalSOC;
+    float departureSOC;
+    int bookingID;     // set by book
+};
+
+struct TripPlan {
+    std::vector<TripLeg> legs;
+    float arrivalTime;
+    float arrivalSOC;
+};
+
+// Plans charging stops along a route through the network with a label-setting
+// search over (stop, time, SOC). At each stop a label either drives on or
+// charges to one of a fixed set of SOC targets on one of the station's docks,
+// starting at the dock's first free window. Labels at a stop that arrive no
+// earlier and with no more charge than another are pruned, so each stop keeps
+// at most one label per SOC target.
+class TripPlanner {
+public:
+    static const int SOC_STEP = 10; // percent between charging targets
+
+    TripPlanner(ChargingNetwork& net) : network(net) {}
+
+    // Finds the plan with the earliest arrival for the vehicle as registered
+    // at the first station of the network that knows it; returns false if the
+    // vehicle is unknown or no plan keeps the battery above the reserve
+    bool plan(const TripRequest& request, TripPlan& result);
+
+    // Books every leg or none. Fails if a leg's window has been taken since
+    // planning, the user or vehicle is unknown at a stop, a station is full,
+    // or the power tree no longer has headroom for the legs together.
+    bool book(const TripRequest& request, TripPlan& plan);
+
+private:
+    struct Label {
+        float time;
+        float soc;
+        int parent;  // index into labels, -1 for the departure
+        TripLeg leg; // valid when hasLeg
+        bool hasLeg;
+    };
+
+    // Reduces front to the labels not dominated in (time, SOC)
+    void prune(std::vector<int>& front) const;
+
+    // Whether the power trees can take every leg at once
+    bool legsFitPowerTree(const TripRequest& request, const TripPlan& plan);
+
+    ChargingNetwork& network;
+    std::vector<Label> labels;
+};
+
+#endif // TRIP_PLANNER_H
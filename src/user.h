@@ -0,0 +1,28 @@
+#ifndef USER_H
+#define USER_H
+
+#include <cstring>
+
+// User class
+class User {
+public:
+    int userID;
+    char name[50];
+    bool isRegistered;
+    int membershipLevel;
+
+    User() : userID(-1), isRegistered(false), membershipLevel(0) {
+        name[0] = '\0';
+    }
+
+    void registerUser(int id, const char* userName, int level) {
+        if (level != 0 && level != 1) level = 0;
+        userID = id;
+        strncpy(name, userName, 49);
+        name[49] = '\0';
+        isRegistered = true;
+        membershipLevel = level;
+    }
+};
+
+#endif // USER_H
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <vector>
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Compares the index's range queries with a scan over every entry
+static void checkRanges(const BookingTimeIndex& index, const vector<IndexEntry>& all) {
+    for (float from = -1.0f; from < 130.0f; from += 7.25f) {
+        for (float length : { 0.5f, 3.0f, 20.0f }) {
+            float to = from + length;
+            vector<int> expected, found;
+            for (const IndexEntry& e : all) {
+                if (e.start >= from && e.start < to) expected.push_back(e.bookingIndex);
+            }
+            float last = -1.0f;
+            bool ordered = true;
+            index.forEachStarting(from, to, [&found, &last, &ordered](const IndexEntry& e) {
+                if (e.start < last) ordered = false;
+                last = e.start;
+                found.push_back(e.bookingIndex);
+            });
+            CHECK(ordered);
+            sort(expected.begin(), expected.end());
+            sort(found.begin(), found.end());
+            CHECK(found == expected);
+
+            expected.clear();
+            found.clear();
+            for (const IndexEntry& e : all) {
+                if (e.start < to && e.end > from) expected.push_back(e.bookingIndex);
+            }
+            index.forEachOverlapping(from, to, [&found](const IndexEntry& e) { found.push_back(e.bookingIndex); });
+            sort(expected.begin(), expected.end());
+            sort(found.begin(), found.end());
+            CHECK(found == expected);
+        }
+    }
+}
+
+// Out-of-order arrivals go through several buffer merges; queries match a
+// full scan before and after each of them
+static void testQueriesAcrossMerges() {
+    BookingTimeIndex index;
+    vector<IndexEntry> all;
+    unsigned int seed = 7;
+    int total = BookingTimeIndex::MAX_DELTA * 3 + 100;
+    for (int i = 0; i < total; i++) {
+        seed = seed * 1103515245u + 12345u;
+        float start;
+        if (i % 3 == 0) start = i * 0.1f; // in order, appended to the run
+        else start = (float)((seed >> 8) % 12000) / 100.0f;
+        float end = start + 0.25f + (float)((seed >> 4) % 16) * 0.25f;
+        IndexEntry e = { start, end, i };
+        all.push_back(e);
+        index.insert(start, end, i);
+        if (i % 150 == 0 || i == total - 1) checkRanges(index, all);
+    }
+    CHECK(index.size() == total);
+    index.clear();
+    CHECK(index.size() == 0);
+    int none = 0;
+    index.forEachStarting(-1000.0f, 1000.0f, [&none](const IndexEntry&) { none++; });
+    CHECK(none == 0);
+}
+
+// Station queries return bookings by start time, and overlapping queries
+// follow sessions shortened after they were indexed
+static void testStationRanges() {
+    ChargingStation st;
+    st.setLog(&testLog);
+    st.registerUser(1, "Regular", 0);
+    st.registerUser(2, "Premium", 1);
+    st.registerVehicle(10, 1, 50.0f, 80.0f, false);
+    st.registerVehicle(20, 2, 50.0f, 80.0f, false);
+    st.setPreemption(true);
+    CHECK(st.placeBooking(1, 10, 4, 4.0f, 3.0f, 3) != -1);
+    CHECK(st.placeBooking(1, 10, 0, 2.0f, 1.0f, 1) != -1);
+    CHECK(st.placeBooking(1, 10, 1, 3.0f, 1.0f, 1) != -1);
+    vector<int> out;
+    CHECK(st.findBookingsInRange(2.0f, 4.5f, out) == 3);
+    CHECK(out.size() == 3 && out[0] == 1 && out[1] == 2 && out[2] == 0);
+    out.clear();
+    CHECK(st.findBookingsInRange(5.5f, 6.0f, out, true) == 1);
+
+    // The premium FAST session cuts the first booking short at 5.0
+    CHECK(st.createBooking(2, 20, 5.0f, 1.0f, FAST, 3));
+    out.clear();
+    CHECK(st.findBookingsInRange(5.5f, 6.0f, out, true) == 1);
+    CHECK(out.size() == 1 && out[0] == 3);
+}
+
+int main() {
+    testQueriesAcrossMerges();
+    testStationRanges();
+    return testResult();
+}
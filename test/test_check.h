@@ -0,0 +1,38 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+// Minimal checks for the behaviour tests. A failed check is reported and the
+// test's main returns testResult(), non-zero after any failure.
+static int testFailures = 0;
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond << std::endl; \
+            testFailures++;                                                              \
+        }                                                                                \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                                          \
+    do {                                                                                 \
+        double a_ = (actual), e_ = (expected);                                           \
+        if (std::fabs(a_ - e_) > (tolerance)) {                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #actual " = " << a_         \
+                      << ", expected " << e_ << std::endl;                               \
+            testFailures++;                                                              \
+        }                                                                                \
+    } while (0)
+
+// Station output is not checked; keep it off the console
+static std::ostringstream testLog;
+
+static int testResult() {
+    if (testFailures > 0) std::cerr << testFailures << " check(s) failed" << std::endl;
+    return testFailures > 0 ? 1 : 0;
+}
+
+#endif // TEST_CHECK_H
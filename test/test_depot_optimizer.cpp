@@ -0,0 +1,110 @@
+#include <vector>
+#include "depot_optimizer.h"
+#include "test_check.h"
+using namespace std;
+
+static DepotVehicle parked(int id, float soc, float capacity, float target, float arrival, float departure) {
+    DepotVehicle dv;
+    dv.vehicle.registerVehicle(id, 1, soc, capacity, false);
+    dv.arrivalTime = arrival;
+    dv.departureTime = departure;
+    dv.targetSOC = target;
+    return dv;
+}
+
+static vector<DepotDock> depotDocks(const vector<float>& ratings) {
+    vector<DepotDock> docks(ratings.size());
+    for (size_t d = 0; d < ratings.size(); d++) {
+        docks[d].dockID = (int)d + 1;
+        docks[d].powerKW = ratings[d];
+    }
+    return docks;
+}
+
+// Per-slot draw of the assignments adds up to the site load and never
+// exceeds the grid capacity
+static void checkSiteLoad(const DepotSchedule& plan, float capacityKW) {
+    vector<float> sum(plan.siteLoadKW.size(), 0.0f);
+    for (const DepotAssignment& a : plan.assignments) {
+        int first = (int)((a.startTime - plan.horizonStart) / plan.slotHours + 0.5f);
+        for (size_t k = 0; k < a.powerKW.size(); k++) sum[first + k] += a.powerKW[k];
+    }
+    for (size_t k = 0; k < sum.size(); k++) {
+        CHECK_NEAR(sum[k], plan.siteLoadKW[k], 1e-2);
+        CHECK(plan.siteLoadKW[k] <= capacityKW + 1e-3f);
+    }
+}
+
+// Every vehicle leaves at its target SOC, charging inside its parking window
+static void testDepartureTargets() {
+    vector<DepotVehicle> fleet;
+    fleet.push_back(parked(1, 20.0f, 60.0f, 80.0f, 18.0f, HOURS_PER_DAY + 6.0f));
+    fleet.push_back(parked(2, 50.0f, 40.0f, 90.0f, 19.0f, HOURS_PER_DAY + 5.0f));
+    fleet.push_back(parked(3, 10.0f, 80.0f, 80.0f, 20.0f, HOURS_PER_DAY + 7.0f));
+    fleet.push_back(parked(4, 90.0f, 50.0f, 80.0f, 20.0f, HOURS_PER_DAY + 7.0f));
+    DepotOptimizer optimizer(DepotOptimizer::standardTariff());
+    DepotSchedule plan = optimizer.optimize(fleet, depotDocks({ (float)MEDIUM, (float)FAST }));
+
+    CHECK(plan.unmetVehicles == 0);
+    CHECK((int)plan.assignments.size() == 4);
+    Millicents total = 0;
+    for (size_t i = 0; i < fleet.size(); i++) {
+        const DepotAssignment& a = plan.assignments[i];
+        const EV& ev = fleet[i].vehicle;
+        CHECK(a.vehicleID == ev.vehicleID);
+        CHECK(a.targetMet);
+        float socAtDeparture = ev.batterySOC + wattHoursToKWh(a.energyWh) / ev.batteryCapacity * 100.0f;
+        CHECK(socAtDeparture >= fleet[i].targetSOC - 1e-3f);
+        float delivered = 0.0f;
+        for (float kw : a.powerKW) delivered += kw * plan.slotHours;
+        CHECK_NEAR(delivered, wattHoursToKWh(a.energyWh), 1e-2);
+        if (a.energyWh == 0) continue;
+        CHECK(a.startTime >= fleet[i].arrivalTime - 1e-4f && a.endTime <= fleet[i].departureTime + 1e-4f);
+        total += a.costMillicents;
+    }
+    CHECK(plan.assignments[3].energyWh == 0); // already above its target
+    CHECK(plan.totalCostMillicents == total);
+
+    // Sessions on the same dock do not overlap
+    for (size_t i = 0; i < plan.assignments.size(); i++) {
+        for (size_t j = i + 1; j < plan.assignments.size(); j++) {
+            const DepotAssignment& a = plan.assignments[i];
+            const DepotAssignment& b = plan.assignments[j];
+            if (a.energyWh == 0 || b.energyWh == 0 || a.dockID != b.dockID) continue;
+            CHECK(a.endTime <= b.startTime || b.endTime <= a.startTime);
+        }
+    }
+    checkSiteLoad(plan, GRID_CAPACITY);
+}
+
+// Five FAST sessions in the same window would draw 250 kW; the site stays
+// within GRID_CAPACITY and the vehicles still reach their targets
+static void testGridCapacity() {
+    vector<DepotVehicle> fleet;
+    for (int v = 1; v <= 5; v++) fleet.push_back(parked(v, 0.0f, 100.0f, 100.0f, 20.0f, HOURS_PER_DAY + 6.0f));
+    DepotOptimizer optimizer(DepotOptimizer::standardTariff());
+    DepotSchedule plan = optimizer.optimize(fleet, depotDocks(vector<float>(5, (float)FAST)));
+    CHECK(plan.unmetVehicles == 0);
+    checkSiteLoad(plan, GRID_CAPACITY);
+    float peak = 0.0f;
+    for (float kw : plan.siteLoadKW) peak = max(peak, kw);
+    CHECK_NEAR(peak, GRID_CAPACITY, 1e-3);
+}
+
+// An overflowed cost total stays reported as -1 while later vehicles are planned
+static void testCostOverflow() {
+    vector<DepotVehicle> fleet;
+    for (int v = 1; v <= 12; v++) fleet.push_back(parked(v, 0.0f, 200.0f, 100.0f, 0.0f, 25.0f));
+    // 1750 Wh per slot at this rate costs 8.75e15 millicents, 8.75e17 per vehicle
+    DepotOptimizer optimizer(vector<Millicents>(HOURS_PER_DAY, 5000000000000000LL));
+    DepotSchedule plan = optimizer.optimize(fleet, depotDocks(vector<float>(12, (float)SLOW)));
+    CHECK(plan.unmetVehicles == 12);
+    CHECK(plan.totalCostMillicents == -1);
+}
+
+int main() {
+    testDepartureTargets();
+    testGridCapacity();
+    testCostOverflow();
+    return testResult();
+}
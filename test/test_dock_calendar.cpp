@@ -0,0 +1,102 @@
+#include <vector>
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+static bool isInterval(const CalendarInterval& c, float start, float end, bool busy) {
+    return c.start == start && c.end == end && c.busy == busy;
+}
+
+static void testEmptyDock() {
+    DockSchedule s;
+    vector<CalendarInterval> out;
+    CHECK(s.calendar(2.0f, 5.0f, out) == 1);
+    CHECK(isInterval(out[0], 2.0f, 5.0f, false));
+}
+
+// Back-to-back reservations merge into one busy interval; a gap stays free
+static void testMergedAtEdges() {
+    DockSchedule s;
+    s.insert(1.0f, 2.0f, 0);
+    s.insert(2.0f, 3.0f, 1);
+    s.insert(4.0f, 5.0f, 2);
+    s.insert(5.0f, 6.0f, 3);
+    vector<CalendarInterval> out;
+    CHECK(s.calendar(0.0f, 8.0f, out) == 5);
+    CHECK(isInterval(out[0], 0.0f, 1.0f, false));
+    CHECK(isInterval(out[1], 1.0f, 3.0f, true));
+    CHECK(isInterval(out[2], 3.0f, 4.0f, false));
+    CHECK(isInterval(out[3], 4.0f, 6.0f, true));
+    CHECK(isInterval(out[4], 6.0f, 8.0f, false));
+}
+
+// Reservations crossing the range are clipped to it; those ending at from
+// or starting at to are left out
+static void testClippedToRange() {
+    DockSchedule s;
+    s.insert(0.0f, 1.0f, 0);
+    s.insert(1.0f, 2.5f, 1);
+    s.insert(3.5f, 5.0f, 2);
+    s.insert(5.0f, 6.0f, 3);
+    vector<CalendarInterval> out;
+    CHECK(s.calendar(2.0f, 4.0f, out) == 3);
+    CHECK(isInterval(out[0], 2.0f, 2.5f, true));
+    CHECK(isInterval(out[1], 2.5f, 3.5f, false));
+    CHECK(isInterval(out[2], 3.5f, 4.0f, true));
+
+    out.clear();
+    CHECK(s.calendar(2.5f, 3.5f, out) == 1);
+    CHECK(isInterval(out[0], 2.5f, 3.5f, false));
+
+    out.clear();
+    CHECK(s.calendar(1.5f, 2.5f, out) == 1);
+    CHECK(isInterval(out[0], 1.5f, 2.5f, true));
+}
+
+// Results are appended, never merged into what out already holds
+static void testAppends() {
+    DockSchedule s;
+    s.insert(1.0f, 2.0f, 0);
+    s.insert(2.0f, 3.0f, 1);
+    vector<CalendarInterval> out;
+    CHECK(s.calendar(0.0f, 2.0f, out) == 2);
+    CHECK(s.calendar(2.0f, 4.0f, out) == 2);
+    CHECK(out.size() == 4);
+    CHECK(isInterval(out[1], 1.0f, 2.0f, true));
+    CHECK(isInterval(out[2], 2.0f, 3.0f, true));
+    CHECK(isInterval(out[3], 3.0f, 4.0f, false));
+}
+
+// The station calendar follows bookings, cancellations and completions
+static void testStationCalendar() {
+    ChargingStation st;
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 50.0f, 80.0f, false);
+    CHECK(st.placeBooking(1, 10, 0, 1.0f, 1.0f, 1) != -1);
+    int middle = st.placeBooking(1, 10, 0, 2.0f, 1.0f, 1);
+    CHECK(st.placeBooking(1, 10, 0, 3.0f, 1.0f, 1) != -1);
+    vector<CalendarInterval> out;
+    CHECK(st.getDockCalendar(0, 0.0f, 5.0f, out) == 3);
+    CHECK(isInterval(out[1], 1.0f, 4.0f, true));
+
+    st.cancelBooking(st.bookings[middle].bookingID);
+    out.clear();
+    CHECK(st.getDockCalendar(0, 0.0f, 5.0f, out) == 5);
+    CHECK(isInterval(out[1], 1.0f, 2.0f, true));
+    CHECK(isInterval(out[2], 2.0f, 3.0f, false));
+    CHECK(isInterval(out[3], 3.0f, 4.0f, true));
+
+    out.clear();
+    CHECK(st.getDockCalendar(1, 0.0f, 5.0f, out) == 1);
+    CHECK(!out[0].busy);
+}
+
+int main() {
+    testEmptyDock();
+    testMergedAtEdges();
+    testClippedToRange();
+    testAppends();
+    testStationCalendar();
+    return testResult();
+}
@@ -0,0 +1,92 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Default docks: 1 SLOW grid, 2 SLOW solar, 3 MEDIUM grid, 4 MEDIUM solar, 5 FAST grid
+static void setUp(ChargingStation& st, DockPolicy policy) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 50.0f, 80.0f, false);
+    st.setDockPolicy(policy);
+}
+
+static void testDefault() {
+    ChargingStation st;
+    setUp(st, POLICY_DEFAULT);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 1);
+    CHECK(st.findAvailableDock(MEDIUM, 1.0f, 1.0f, false) == 3);
+    CHECK(st.findAvailableDock(SLOW, 13.0f, 1.0f, false) == 2); // solar first at peak
+}
+
+static void testBestFit() {
+    ChargingStation st;
+    setUp(st, POLICY_BEST_FIT);
+    CHECK(st.findAvailableDock(MEDIUM, 1.0f, 1.0f, false) == 3);
+    CHECK(st.findAvailableDock(FAST, 1.0f, 1.0f, false) == 5);
+    CHECK(st.placeBooking(1, 10, 2, 1.0f, 1.0f, 2) != -1);
+    CHECK(st.placeBooking(1, 10, 3, 1.0f, 1.0f, 2) != -1);
+    CHECK(st.findAvailableDock(MEDIUM, 1.0f, 1.0f, false) == 5);
+}
+
+static void testLeastLoaded() {
+    ChargingStation st;
+    setUp(st, POLICY_LEAST_LOADED);
+    CHECK(st.placeBooking(1, 10, 0, 5.0f, 2.0f, 1) != -1);
+    CHECK(st.placeBooking(1, 10, 2, 5.0f, 1.0f, 2) != -1);
+    CHECK(st.placeBooking(1, 10, 3, 5.0f, 1.0f, 2) != -1);
+    CHECK(st.placeBooking(1, 10, 4, 5.0f, 0.5f, 3) != -1);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 2);
+    CHECK(st.placeBooking(1, 10, 1, 8.0f, 3.0f, 1) != -1);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 5);
+}
+
+static void testSolarFirst() {
+    ChargingStation st;
+    setUp(st, POLICY_SOLAR_FIRST);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 2);
+    CHECK(st.findAvailableDock(MEDIUM, 1.0f, 1.0f, false) == 4);
+    currentWeather = NIGHT; // no solar output, so the tightest grid dock
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 1);
+    currentWeather = SUNNY;
+}
+
+static void testWearLeveling() {
+    ChargingStation st;
+    setUp(st, POLICY_WEAR_LEVELING);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 1);
+    int first = st.placeBooking(1, 10, 0, 1.0f, 1.0f, 1);
+    CHECK(first != -1);
+    st.completeBooking(st.bookings[first].bookingID);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 2);
+}
+
+static void testCarbonAware() {
+    ChargingStation st;
+    setUp(st, POLICY_CARBON_AWARE);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 1.0f, false) == 2);
+    CHECK(st.findAvailableDock(MEDIUM, 1.0f, 1.0f, false) == 4);
+    CHECK(st.findAvailableDock(FAST, 1.0f, 1.0f, false) == 5);
+}
+
+// Bookings and batches go through the station's policy
+static void testBookingUsesPolicy() {
+    ChargingStation st;
+    setUp(st, POLICY_SOLAR_FIRST);
+    CHECK(st.createBooking(1, 10, 1.0f, 1.0f, SLOW, 1));
+    CHECK(st.bookings[0].dockID == 2);
+    BookingRequest request = { 1, 10, 3.0f, 1.0f, MEDIUM, 2 };
+    BookingResult result;
+    CHECK(st.createBookings(&request, 1, &result) == 1);
+    CHECK(result.dockID == 4);
+}
+
+int main() {
+    testDefault();
+    testBestFit();
+    testLeastLoaded();
+    testSolarFirst();
+    testWearLeveling();
+    testCarbonAware();
+    testBookingUsesPolicy();
+    return testResult();
+}
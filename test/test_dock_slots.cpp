@@ -0,0 +1,65 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 50.0f, 80.0f, false);
+}
+
+static void testDefaultLookups() {
+    ChargingStation st;
+    setUp(st);
+    for (int slot = 0; slot < MAX_DOCKS; slot++) CHECK(st.dockSlot(slot + 1) == slot);
+    CHECK(st.dockSlot(0) == -1);
+    CHECK(st.dockSlot(-1) == -1);
+    CHECK(st.dockSlot(MAX_DOCKS + 1) == -1);
+    CHECK(st.dockSlot(MAX_DOCK_ID + 1) == -1);
+}
+
+// Re-initializing a slot under a new ID moves the lookup with it
+static void testReinitializedDock() {
+    ChargingStation st;
+    setUp(st);
+    st.initializeDock(2, 40, MEDIUM, new GridPower());
+    CHECK(st.dockSlot(40) == 2);
+    CHECK(st.dockSlot(3) == -1);
+    CHECK(!st.isDockAvailable(3, 1.0f, 1.0f));
+    CHECK(st.isDockAvailable(40, 1.0f, 1.0f));
+
+    CHECK(st.createBooking(1, 10, 1.0f, 1.0f, MEDIUM, 2));
+    CHECK(st.bookings[0].dockID == 40 && st.bookings[0].dockSlot == 2);
+    CHECK(!st.isDockAvailable(40, 1.0f, 1.0f));
+    st.completeBooking(st.bookings[0].bookingID);
+    CHECK(st.completedSessions[2] == 1);
+    CHECK(st.isDockAvailable(40, 1.0f, 1.0f));
+
+    // The FAST slot rewired as a SLOW AC dock leaves the DC set
+    st.initializeDock(4, MAX_DOCK_ID, SLOW, new GridPower());
+    CHECK(st.dockSlot(MAX_DOCK_ID) == 4);
+    CHECK(st.dockSlot(5) == -1);
+    CHECK(!(st.dcDocks & (1u << 4)));
+    CHECK(st.findAvailableDock(FAST, 1.0f, 1.0f, false) == -1);
+    CHECK(st.setDockPhases(MAX_DOCK_ID, PHASE_L2));
+    CHECK(!st.setDockPhases(5, PHASE_L2));
+}
+
+// An invalid ID leaves the slot and its lookup unchanged
+static void testInvalidInitialization() {
+    ChargingStation st;
+    setUp(st);
+    st.initializeDock(1, 0, MEDIUM, new GridPower());
+    st.initializeDock(1, MAX_DOCK_ID + 1, MEDIUM, new GridPower());
+    st.initializeDock(MAX_DOCKS, 9, MEDIUM, new GridPower());
+    CHECK(st.dockSlot(2) == 1);
+    CHECK(st.docks[1].dockID == 2);
+    CHECK(st.dockSlot(9) == -1);
+}
+
+int main() {
+    testDefaultLookups();
+    testReinitializedDock();
+    testInvalidInitialization();
+    return testResult();
+}
@@ -0,0 +1,50 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Regular user 1 owns vehicle 10, premium user 2 vehicles 20 and 21
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Regular", 0);
+    st.registerUser(2, "Premium", 1);
+    st.registerVehicle(10, 1, 50.0f, 80.0f, false);
+    st.registerVehicle(20, 2, 50.0f, 80.0f, false);
+    st.registerVehicle(21, 2, 50.0f, 80.0f, false);
+    st.setFairShare(true);
+}
+
+// Bookings placed directly, or confirmed from a hold, count as served
+static void testPlacementRecordsServed() {
+    ChargingStation st;
+    setUp(st);
+    CHECK(st.placeBooking(2, 20, 0, 1.0f, 1.0f, 1) != -1);
+    CHECK(st.fairShare.normalizedUsage(1) > 0.0f);
+    int hold = st.holdBooking(1, 10, 3.0f, 1.0f, SLOW, 1, 0, 30);
+    CHECK(hold != -1);
+    CHECK_NEAR(st.fairShare.normalizedUsage(0), 0.0f, 1e-6);
+    CHECK(st.confirmHold(hold, 1));
+    CHECK(st.fairShare.normalizedUsage(0) > 0.0f);
+}
+
+// Once a premium admission in a batch takes the tier over its share, its
+// next peak-hour request is deferred like a regular one
+static void testBatchRechecksShare() {
+    ChargingStation st;
+    setUp(st);
+    CHECK(st.createBooking(1, 10, 1.0f, 0.5f, SLOW, 1));
+    BookingRequest requests[2] = {
+        { 2, 20, 13.0f, 2.0f, SLOW, 1 },
+        { 2, 21, 13.0f, 2.0f, SLOW, 1 },
+    };
+    BookingResult results[2];
+    CHECK(st.createBookings(requests, 2, results) == 2);
+    CHECK_NEAR(results[0].startTime, 13.0f, 1e-6);
+    CHECK_NEAR(results[1].startTime, PEAK_END, 1e-6);
+    CHECK(st.fairShare.isOverShare(1));
+}
+
+int main() {
+    testPlacementRecordsServed();
+    testBatchRechecksShare();
+    return testResult();
+}
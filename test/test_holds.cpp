@@ -0,0 +1,43 @@
+#include <sstream>
+#include <string>
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Expired and released holds are reported as such, and left out of the
+// session and utilisation figures
+static void testLapsedHoldsNotCompleted() {
+    ChargingStation st;
+    ostringstream out;
+    st.setLog(&out);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 20.0f, 80.0f, false);
+    st.registerVehicle(11, 1, 20.0f, 80.0f, false);
+    st.registerVehicle(12, 1, 20.0f, 80.0f, false);
+    CHECK(st.createBooking(1, 12, 1.0f, 1.0f, SLOW, 1));
+    int expired = st.holdBooking(1, 10, 1.0f, 2.0f, SLOW, 1, 0, 30);
+    int released = st.holdBooking(1, 11, 1.0f, 4.0f, SLOW, 1, 0, 30);
+    CHECK(expired != -1 && released != -1);
+    CHECK(st.releaseHold(released));
+    CHECK(st.expireHolds(30) == 1);
+    CHECK(st.bookings[expired - 1].isExpired && !st.bookings[expired - 1].isFinished());
+    CHECK(st.bookings[released - 1].isExpired);
+
+    st.completeBooking(1);
+
+    out.str("");
+    st.viewUserBookings(1);
+    CHECK(out.str().find("Status: Completed") != string::npos);
+    CHECK(out.str().find("Status: Expired") != string::npos);
+
+    out.str("");
+    st.generateReport();
+    // One hour on one of five docks over the completed session's one hour
+    CHECK(out.str().find("Station Utilization: 20%") != string::npos);
+    CHECK(out.str().find("Average Session Duration: 1 hours") != string::npos);
+}
+
+int main() {
+    testLapsedHoldsNotCompleted();
+    return testResult();
+}
@@ -0,0 +1,51 @@
+#include <atomic>
+#include <thread>
+#include "idempotency_table.h"
+#include "test_check.h"
+using namespace std;
+
+static void testLookupAndExpiry() {
+    IdempotencyTable table(8, 60);
+    IdempotentResult r = { 1, OP_CREATE_BOOKING, 42 }, found;
+    CHECK(!table.lookup(7, 0, found));
+    table.record(7, 0, r);
+    table.record(0, 0, r);
+    CHECK(table.lookup(7, 59, found) && found.value == 42 && found.operation == OP_CREATE_BOOKING);
+    CHECK(!table.lookup(7, 60, found));
+    CHECK(!table.lookup(0, 0, found));
+}
+
+// Readers racing a writer never see a result mixed from two writes; the
+// writer keeps stationID, operation and value equal
+static void testConcurrentReadsConsistent() {
+    IdempotencyTable table(4, 1000000);
+    atomic<bool> done(false);
+    atomic<int> torn(0);
+    thread writer([&table, &done] {
+        for (int i = 1; i <= 20000; i++) {
+            IdempotentResult r = { i, i, i };
+            table.record(1 + i % 3, 0, r);
+        }
+        done.store(true);
+    });
+    thread readers[2];
+    for (thread& t : readers) {
+        t = thread([&table, &done, &torn] {
+            IdempotentResult r;
+            while (!done.load()) {
+                for (unsigned long long key = 1; key <= 3; key++) {
+                    if (table.lookup(key, 0, r) && (r.stationID != r.operation || r.operation != r.value)) torn++;
+                }
+            }
+        });
+    }
+    writer.join();
+    for (thread& t : readers) t.join();
+    CHECK(torn.load() == 0);
+}
+
+int main() {
+    testLookupAndExpiry();
+    testConcurrentReadsConsistent();
+    return testResult();
+}
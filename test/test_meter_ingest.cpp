@@ -0,0 +1,69 @@
+#include "meter_ingest.h"
+#include "test_check.h"
+using namespace std;
+
+static const long long HOUR_MS = 3600000;
+
+// Station with a 1.0-2.0 session and a 2.0-3.0 session on dock 1
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 20.0f, 80.0f, false);
+    st.registerVehicle(11, 1, 20.0f, 80.0f, false);
+    st.placeBooking(1, 10, 0, 1.0f, 1.0f, 1);
+    st.placeBooking(1, 11, 0, 2.0f, 1.0f, 1);
+}
+
+static MeterReading reading(long long ms, float kW, long long registerWh = -1) {
+    MeterReading r = { 1, ms, kW, registerWh };
+    return r;
+}
+
+// 7 kW sampled every 10 s from 10 s into the session up to its end: the gap
+// before the first reading and the interval ending on the session end count
+static void testSessionBoundsCovered() {
+    ChargingStation st;
+    setUp(st);
+    MeterIngestor meter(st);
+    for (long long t = HOUR_MS + 10000; t <= 2 * HOUR_MS; t += 10000) CHECK(meter.push(reading(t, 7.0f)));
+    meter.process();
+    CHECK(st.bookings[0].measuredWh == 7000);
+    CHECK(st.bookings[1].measuredWh == -1);
+}
+
+// An interval spanning a session change is split at the boundary, each side
+// held at the reading inside its session
+static void testIntervalSplitAtBoundary() {
+    ChargingStation st;
+    setUp(st);
+    MeterIngestor meter(st);
+    meter.push(reading(HOUR_MS, 6.0f));
+    meter.push(reading(2 * HOUR_MS - HOUR_MS / 4, 6.0f));
+    meter.push(reading(2 * HOUR_MS + HOUR_MS / 4, 4.0f));
+    meter.push(reading(3 * HOUR_MS, 4.0f));
+    meter.process();
+    CHECK(st.bookings[0].measuredWh == 6000);
+    CHECK(st.bookings[1].measuredWh == 4000);
+}
+
+// Registers are used between readings inside a session; late readings are dropped
+static void testRegistersAndOrdering() {
+    ChargingStation st;
+    setUp(st);
+    MeterIngestor meter(st);
+    meter.push(reading(HOUR_MS, 0.0f, 100000));
+    meter.push(reading(HOUR_MS + HOUR_MS / 2, 0.0f, 103000));
+    meter.push(reading(HOUR_MS + HOUR_MS / 4, 5.0f, 101000));
+    meter.push(reading(2 * HOUR_MS, 0.0f, 105500));
+    meter.process();
+    CHECK(st.bookings[0].measuredWh == 5500);
+    CHECK(meter.rejected() == 1);
+    CHECK(st.priceBooking(0).energyWh == 5500);
+}
+
+int main() {
+    testSessionBoundsCovered();
+    testIntervalSplitAtBoundary();
+    testRegistersAndOrdering();
+    return testResult();
+}
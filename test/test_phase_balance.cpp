@@ -0,0 +1,83 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Station of three grid SLOW docks, one per phase, plus a FAST dock; user 1 owns vehicles 10-12
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    for (int v = 10; v <= 12; v++) st.registerVehicle(v, 1, 20.0f, 80.0f, false);
+    st.initializeDock(1, 2, SLOW, new GridPower());
+    st.initializeDock(2, 3, SLOW, new GridPower());
+    st.initializeDock(3, 4, FAST, new GridPower());
+}
+
+// The phase load counts bookings overlapping the requested interval only
+static void testLoadFollowsInterval() {
+    ChargingStation st;
+    setUp(st);
+    st.setPhaseBalancing(true);
+    CHECK(st.placeBooking(1, 10, 0, 1.0f, 2.0f, 1) != -1);
+    CHECK(st.placeBooking(1, 11, 3, 5.0f, 1.0f, 3) != -1);
+    float load[PHASES];
+    st.phaseLoadOver(1.5f, 2.5f, load);
+    CHECK_NEAR(load[0], 7.0f, 1e-4);
+    CHECK_NEAR(load[1], 0.0f, 1e-4);
+    st.phaseLoadOver(3.0f, 4.0f, load);
+    CHECK_NEAR(load[0] + load[1] + load[2], 0.0f, 1e-4);
+    st.phaseLoadOver(4.5f, 5.5f, load);
+    for (int p = 0; p < PHASES; p++) CHECK_NEAR(load[p], FAST / 3.0f, 1e-3);
+}
+
+// With two docks wired to L1 and a 10 kW limit, L1 takes one SLOW session
+// at a time: an earlier session fits beside a later booking, an overlapping
+// one goes to another phase
+static void testSelectionByPhase() {
+    ChargingStation st;
+    setUp(st);
+    CHECK(st.setDockPhases(2, PHASE_L1));
+    st.setPhaseBalancing(true, 10.0f);
+    CHECK(st.placeBooking(1, 10, 0, 4.0f, 2.0f, 1) != -1);
+    CHECK(st.findAvailableDock(SLOW, 1.0f, 2.0f, false, 2u) == 2);
+    CHECK(st.findAvailableDock(SLOW, 5.0f, 1.0f, false, 2u) == -1);
+    CHECK(st.findAvailableDock(SLOW, 5.0f, 1.0f, false, 7u) == 3);
+}
+
+// The bucketed load follows releases and rewiring, and bookings made while
+// balancing was off are picked up when it is turned on
+static void testLoadMaintained() {
+    ChargingStation st;
+    setUp(st);
+    int early = st.placeBooking(1, 10, 1, 1.0f, 2.0f, 1);
+    CHECK(early != -1);
+    float load[PHASES];
+    st.phaseLoadOver(1.0f, 3.0f, load);
+    CHECK_NEAR(load[1], 0.0f, 1e-4);
+    st.setPhaseBalancing(true);
+    st.phaseLoadOver(1.0f, 3.0f, load);
+    CHECK_NEAR(load[1], 7.0f, 1e-4);
+
+    CHECK(st.setDockPhases(2, PHASE_L3));
+    st.phaseLoadOver(1.0f, 3.0f, load);
+    CHECK_NEAR(load[1], 0.0f, 1e-4);
+    CHECK_NEAR(load[2], 7.0f, 1e-4);
+
+    int late = st.placeBooking(1, 11, 1, 3.0f, 1.0f, 1);
+    CHECK(late != -1);
+    st.phaseLoadOver(0.0f, 24.0f, load);
+    CHECK_NEAR(load[2], 7.0f, 1e-4); // back to back, never drawing together
+    st.cancelBooking(st.bookings[early].bookingID);
+    st.phaseLoadOver(1.0f, 3.0f, load);
+    CHECK_NEAR(load[2], 0.0f, 1e-4);
+    vector<Invoice> ledger;
+    st.settleBookings(24.0f, ledger);
+    st.phaseLoadOver(0.0f, 24.0f, load);
+    CHECK_NEAR(load[0] + load[1] + load[2], 0.0f, 1e-4);
+}
+
+int main() {
+    testLoadFollowsInterval();
+    testSelectionByPhase();
+    testLoadMaintained();
+    return testResult();
+}
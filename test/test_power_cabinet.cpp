@@ -0,0 +1,95 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+static void testShareLevelMixedRatings() {
+    ChargingDock docks[3];
+    docks[0].initialize(1, SLOW, nullptr);
+    docks[1].initialize(2, MEDIUM, nullptr);
+    docks[2].initialize(3, FAST, nullptr);
+    PowerCabinet c;
+    c.powerKW = 60.0f;
+    c.connectors = 7;
+    // 20 each caps the 7 kW connector, 26.5 then caps the 22 kW one
+    CHECK_NEAR(c.shareLevel(7, docks), 31.0f, 1e-4);
+    CHECK_NEAR(c.shareLevel(6, docks), 38.0f, 1e-4);
+    CHECK_NEAR(c.shareLevel(5, docks), 53.0f, 1e-4);
+    CHECK_NEAR(c.shareLevel(4, docks), 60.0f, 1e-4);
+    c.powerKW = 100.0f; // enough for every connector
+    CHECK(c.shareLevel(7, docks) >= FAST);
+    c.powerKW = 15.0f; // nobody capped
+    CHECK_NEAR(c.shareLevel(7, docks), 5.0f, 1e-4);
+}
+
+// Three connectors of a 60 kW cabinet in use at once are allocated the
+// whole cabinet, and a session's energy follows its share
+static void testStationAllocation() {
+    ChargingStation st(1);
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    for (int v = 10; v <= 12; v++) st.registerVehicle(v, 1, 20.0f, 80.0f, false);
+    int ids[3] = { 1, 3, 5 };
+    CHECK(st.addCabinet(60.0f, ids, 3) == 0);
+    int slow = st.placeBooking(1, 10, 0, 1.0f, 1.0f, 1);
+    int medium = st.placeBooking(1, 11, 2, 1.0f, 1.0f, 2);
+    int fast = st.placeBooking(1, 12, 4, 1.0f, 2.0f, 3);
+    CHECK(slow != -1 && medium != -1 && fast != -1);
+    CHECK_NEAR(st.docks[0].allocatedKW, 7.0f, 1e-4);
+    CHECK_NEAR(st.docks[2].allocatedKW, 22.0f, 1e-4);
+    CHECK_NEAR(st.docks[4].allocatedKW, 31.0f, 1e-4);
+    CHECK_NEAR(st.docks[0].allocatedKW + st.docks[2].allocatedKW + st.docks[4].allocatedKW, 60.0f, 1e-4);
+    // 31 kW while the others charge, then the full 50 kW for the second hour
+    CHECK_NEAR(st.sessionEnergy(fast), 81.0f, 1e-3);
+}
+
+// Two MEDIUM grid docks sharing 22 kW, both booked 1.0-3.0
+static void bookSharedPair(ChargingStation& st, int& a, int& b) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 20.0f, 80.0f, false);
+    st.registerVehicle(11, 1, 20.0f, 80.0f, false);
+    st.initializeDock(0, 1, MEDIUM, new GridPower());
+    st.initializeDock(1, 2, MEDIUM, new GridPower());
+    int ids[2] = { 1, 2 };
+    CHECK(st.addCabinet(22.0f, ids, 2) == 0);
+    a = st.placeBooking(1, 10, 0, 1.0f, 2.0f, 2);
+    b = st.placeBooking(1, 11, 1, 1.0f, 2.0f, 2);
+    CHECK(a != -1 && b != -1);
+}
+
+// Completed siblings still count toward the share, so invoices do not
+// depend on which session is completed first
+static void testCompletionOrder() {
+    ChargingStation first(1), second(1);
+    int a1, b1, a2, b2;
+    bookSharedPair(first, a1, b1);
+    bookSharedPair(second, a2, b2);
+    first.completeBooking(first.bookings[a1].bookingID);
+    first.completeBooking(first.bookings[b1].bookingID);
+    second.completeBooking(second.bookings[b2].bookingID);
+    second.completeBooking(second.bookings[a2].bookingID);
+    CHECK(first.bookings[a1].energyWh == 22000);
+    CHECK(first.bookings[b1].energyWh == 22000);
+    CHECK(first.bookings[a1].energyWh == second.bookings[a2].energyWh);
+    CHECK(first.bookings[b1].energyWh == second.bookings[b2].energyWh);
+    CHECK(first.bookings[a1].costMillicents == second.bookings[a2].costMillicents);
+    CHECK(first.bookings[b1].costMillicents == second.bookings[b2].costMillicents);
+}
+
+// A cancelled sibling never drew power and leaves the whole cabinet
+static void testCancelledSiblingIgnored() {
+    ChargingStation st(1);
+    int a, b;
+    bookSharedPair(st, a, b);
+    st.cancelBooking(st.bookings[b].bookingID);
+    st.completeBooking(st.bookings[a].bookingID);
+    CHECK(st.bookings[a].energyWh == 44000);
+}
+
+int main() {
+    testShareLevelMixedRatings();
+    testStationAllocation();
+    testCompletionOrder();
+    testCancelledSiblingIgnored();
+    return testResult();
+}
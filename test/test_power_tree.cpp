@@ -0,0 +1,113 @@
+#include <vector>
+#include "charging_network.h"
+#include "test_check.h"
+using namespace std;
+
+// Network with one 60 kW feeder over two 60 kW sites; user 1 owns vehicles 10-12 everywhere
+static void setUp(ChargingNetwork& network, int& feeder) {
+    for (int s = 0; s < MAX_STATIONS; s++) {
+        ChargingStation& st = *network.stations[s];
+        st.setLog(&testLog);
+        st.registerUser(1, "Test", 0);
+        for (int v = 10; v <= 12; v++) st.registerVehicle(v, 1, 20.0f, 80.0f, false);
+    }
+    int substation = network.powerTree.addNode(-1, 200.0f);
+    feeder = network.powerTree.addNode(substation, 60.0f);
+    network.addSite(1, feeder, 60.0f);
+    network.addSite(2, feeder, 60.0f);
+}
+
+static void testTreeHeadroom() {
+    PowerConstraintTree tree(48.0f, 0.25f);
+    int root = tree.addNode(-1, 100.0f);
+    int child = tree.addNode(root, 30.0f);
+    CHECK(tree.addNode(5, 10.0f) == -1);
+    tree.addLoad(child, 1.0f, 3.0f, 20.0f);
+    CHECK_NEAR(tree.headroom(child, 2.0f, 4.0f), 10.0f, 1e-4);
+    CHECK_NEAR(tree.headroom(child, 3.0f, 4.0f), 30.0f, 1e-4);
+    CHECK_NEAR(tree.peakLoad(root, 0.0f, 24.0f), 20.0f, 1e-4);
+    tree.addLoad(root, 2.5f, 5.0f, 75.0f);
+    CHECK_NEAR(tree.headroom(child, 2.0f, 3.0f), 5.0f, 1e-4); // the root is the binding limit
+    tree.addLoad(child, 1.0f, 3.0f, -20.0f);
+    CHECK_NEAR(tree.headroom(child, 0.0f, 2.0f), 30.0f, 1e-4);
+}
+
+static void testFeederSharedBetweenSites() {
+    ChargingNetwork network;
+    int feeder;
+    setUp(network, feeder);
+    ChargingStation& a = *network.stations[0];
+    ChargingStation& b = *network.stations[1];
+    CHECK(a.createBooking(1, 10, 1.0f, 2.0f, FAST, 3));
+    CHECK_NEAR(a.powerHeadroom(1.0f, 3.0f), 10.0f, 1e-4);
+    CHECK(!b.createBooking(1, 10, 1.0f, 2.0f, MEDIUM, 2)); // only 10 kW left on the feeder
+    CHECK(b.createBooking(1, 11, 1.5f, 2.0f, SLOW, 1));
+}
+
+static void testSettlementReleasesLoad() {
+    ChargingNetwork network;
+    int feeder;
+    setUp(network, feeder);
+    ChargingStation& a = *network.stations[0];
+    CHECK(a.createBooking(1, 10, 1.0f, 2.0f, FAST, 3));
+    CHECK(a.holdBooking(1, 11, 1.0f, 1.0f, SLOW, 1, 0, 3600) != -1);
+    CHECK(a.powerHeadroom(1.0f, 3.0f) < 10.0f);
+    vector<Invoice> ledger;
+    CHECK(a.settleBookings(4.0f, ledger, 1) == 1);
+    CHECK_NEAR(a.powerHeadroom(1.0f, 3.0f), 60.0f, 1e-4);
+    CHECK_NEAR(network.powerTree.peakLoad(feeder, 0.0f, 24.0f), 0.0f, 1e-4);
+}
+
+// A SLOW session on a 22 kW dock under a 16 kW site is billed on the
+// 16 kW grant, whether it is completed on its own or settled
+static void testBilledOnGrantedPower() {
+    PowerConstraintTree tree;
+    int site = tree.addNode(-1, 16.0f);
+    ChargingStation completed(1), settled(2);
+    ChargingStation* stations[2] = { &completed, &settled };
+    for (ChargingStation* st : stations) {
+        st->setLog(&testLog);
+        st->registerUser(1, "Test", 0);
+        st->registerVehicle(10, 1, 20.0f, 80.0f, false);
+        for (int slot = 0; slot < 2; slot++) st->initializeDock(slot, slot + 1, MEDIUM, new GridPower());
+        st->attachPowerTree(&tree, site);
+        CHECK(st->createBooking(1, 10, 1.0f, 1.0f, SLOW, 2));
+        CHECK_NEAR(st->bookings[0].gridKW, 16.0f, 1e-4);
+        if (st == &completed) {
+            completed.completeBooking(1);
+        } else {
+            vector<Invoice> ledger;
+            settled.settleBookings(2.0f, ledger, 1);
+        }
+    }
+    CHECK(completed.bookings[0].energyWh == 16000);
+    CHECK(settled.bookings[0].energyWh == 16000);
+}
+
+// Direct placement is refused once the headroom is below the charging
+// type's rating, instead of admitting a session with no grid allocation
+static void testPlacementNeedsHeadroom() {
+    PowerConstraintTree tree;
+    int site = tree.addNode(-1, 10.0f);
+    ChargingStation st(1);
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 20.0f, 80.0f, false);
+    st.registerVehicle(11, 1, 20.0f, 80.0f, false);
+    st.attachPowerTree(&tree, site);
+    CHECK(st.placeBooking(1, 10, 0, 1.0f, 1.0f, 3) == -1);
+    int first = st.placeBooking(1, 10, 0, 1.0f, 1.0f, 1);
+    CHECK(first != -1);
+    CHECK_NEAR(st.bookings[first].gridKW, 7.0f, 1e-4);
+    CHECK(st.placeBooking(1, 11, 1, 1.0f, 1.0f, 1) == -1);
+    CHECK(st.bookingCount == 1);
+}
+
+int main() {
+    testTreeHeadroom();
+    testFeederSharedBetweenSites();
+    testSettlementReleasesLoad();
+    testBilledOnGrantedPower();
+    testPlacementNeedsHeadroom();
+    return testResult();
+}
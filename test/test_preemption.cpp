@@ -0,0 +1,67 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Regular user 1 owns vehicles 10-12, premium user 2 vehicle 20. Only dock 5
+// (slot 4) is rated for FAST requests.
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Regular", 0);
+    st.registerUser(2, "Premium", 1);
+    for (int v = 10; v <= 12; v++) st.registerVehicle(v, 1, 50.0f, 80.0f, false);
+    st.registerVehicle(20, 2, 50.0f, 80.0f, false);
+    st.setPreemption(true);
+}
+
+// A critical booking shortens the session running into its start and moves
+// the one starting inside its interval to another dock
+static void testBumpedBookingMoved() {
+    ChargingStation st;
+    setUp(st);
+    int shortened = st.placeBooking(1, 10, 4, 0.0f, 1.5f, 2);
+    int moved = st.placeBooking(1, 11, 4, 1.5f, 1.0f, 2);
+    CHECK(shortened != -1 && moved != -1);
+    CHECK(st.createBooking(2, 20, 1.0f, 1.5f, FAST, 3));
+    const Booking& priority = st.bookings[st.bookingCount - 1];
+    CHECK(priority.dockID == 5);
+
+    CHECK(st.bookings[shortened].isActive && st.bookings[shortened].dockID == 5);
+    CHECK_NEAR(st.bookings[shortened].duration, 1.0f, 1e-6);
+
+    const Booking& b = st.bookings[moved];
+    CHECK(b.isActive && b.dockID != 5);
+    CHECK(b.dockSlot == st.dockSlot(b.dockID));
+    CHECK_NEAR(b.startTime, 1.5f, 1e-6);
+    CHECK(st.docks[b.dockSlot].powerRating >= MEDIUM);
+    CHECK(st.schedules[4].size() == 2);
+    CHECK(!st.schedules[b.dockSlot].isFree(1.5f, 2.5f));
+}
+
+// With every other dock taken, the bumped booking is cancelled and queued
+static void testBumpedBookingQueued() {
+    ChargingStation st;
+    setUp(st);
+    for (int slot = 0; slot < 4; slot++) CHECK(st.placeBooking(1, 12, slot, 0.0f, 4.0f, 1) != -1);
+    int bumped = st.placeBooking(1, 11, 4, 1.5f, 1.0f, 2);
+    CHECK(st.createBooking(2, 20, 1.0f, 1.5f, FAST, 3));
+    CHECK(!st.bookings[bumped].isActive);
+    CHECK(st.bookingQueues[0].size() == 1);
+    CHECK(st.bookingQueues[0].front().vehicleID == 11);
+}
+
+// Without preemption the critical request is refused instead
+static void testDisabled() {
+    ChargingStation st;
+    setUp(st);
+    st.setPreemption(false);
+    int kept = st.placeBooking(1, 11, 4, 1.5f, 1.0f, 2);
+    CHECK(!st.createBooking(2, 20, 1.0f, 1.5f, FAST, 3));
+    CHECK(st.bookings[kept].isActive && st.bookings[kept].dockID == 5);
+}
+
+int main() {
+    testBumpedBookingMoved();
+    testBumpedBookingQueued();
+    testDisabled();
+    return testResult();
+}
@@ -0,0 +1,23 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// The peak surcharge follows the time of day on every day of the horizon
+static void testPeakByTimeOfDay() {
+    ChargingStation st(1);
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 20.0f, 80.0f, false);
+    int peak = st.placeBooking(1, 10, 0, 14.0f, 1.0f, 1);
+    int laterPeak = st.placeBooking(1, 10, 0, 2 * HOURS_PER_DAY + 14.0f, 1.0f, 1);
+    int offPeak = st.placeBooking(1, 10, 0, 6.0f, 1.0f, 1);
+    int laterOffPeak = st.placeBooking(1, 10, 0, HOURS_PER_DAY + 6.0f, 1.0f, 1);
+    CHECK(st.priceBooking(peak).rateMillicentsPerKWh > st.priceBooking(offPeak).rateMillicentsPerKWh);
+    CHECK(st.priceBooking(laterPeak).costMillicents == st.priceBooking(peak).costMillicents);
+    CHECK(st.priceBooking(laterOffPeak).costMillicents == st.priceBooking(offPeak).costMillicents);
+}
+
+int main() {
+    testPeakByTimeOfDay();
+    return testResult();
+}
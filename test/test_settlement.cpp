@@ -0,0 +1,56 @@
+#include <vector>
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// Docks 1 and 2 share a 22 kW cabinet; the other docks stand alone. Sessions
+// overlap on the cabinet and follow each other on the other docks.
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerUser(2, "Premium", 1);
+    for (int v = 10; v <= 14; v++) st.registerVehicle(v, v % 2 + 1, 20.0f + v, 60.0f + v, false);
+    st.initializeDock(0, 1, MEDIUM, new GridPower());
+    st.initializeDock(1, 2, MEDIUM, new GridPower());
+    int ids[2] = { 1, 2 };
+    st.addCabinet(22.0f, ids, 2);
+    CHECK(st.placeBooking(2, 11, 0, 1.0f, 2.0f, 2) != -1);
+    CHECK(st.placeBooking(1, 10, 1, 2.0f, 2.0f, 2) != -1);
+    CHECK(st.placeBooking(1, 12, 2, 1.0f, 1.5f, 2) != -1);
+    CHECK(st.placeBooking(2, 13, 2, 3.0f, 1.0f, 2) != -1);
+    CHECK(st.placeBooking(1, 14, 4, 17.5f, 0.5f, 3) != -1);
+    CHECK(st.placeBooking(2, 11, 3, 2.0f, 3.0f, 4) != -1);
+}
+
+// Settling gives every session the invoice and SOC gain that completing the
+// sessions one by one gives
+static void testSettleMatchesSequential(int threads) {
+    ChargingStation settled(1), sequential(1);
+    setUp(settled);
+    setUp(sequential);
+    vector<Invoice> ledger;
+    CHECK(settled.settleBookings(24.0f, ledger, threads) == settled.bookingCount);
+    CHECK((int)ledger.size() == settled.bookingCount);
+    for (int i = 0; i < sequential.bookingCount; i++) sequential.completeBooking(sequential.bookings[i].bookingID);
+
+    for (const Invoice& inv : ledger) {
+        const Booking& b = sequential.bookings[inv.bookingID - 1];
+        CHECK(inv.energyWh == b.energyWh);
+        CHECK(inv.costMillicents == b.costMillicents);
+        CHECK(settled.bookings[inv.bookingID - 1].energyWh == b.energyWh);
+    }
+    CHECK(ledger[0].energyWh == 33000); // 22 kW alone, then 11 kW beside booking 2
+    for (int v = 0; v < settled.vehicleCount; v++) {
+        CHECK_NEAR(settled.vehicles[v].batterySOC, sequential.vehicles[v].batterySOC, 1e-4);
+    }
+    for (int d = 0; d < MAX_DOCKS; d++) {
+        CHECK(settled.schedules[d].empty() && sequential.schedules[d].empty());
+        CHECK(settled.completedSessions[d] == sequential.completedSessions[d]);
+    }
+}
+
+int main() {
+    testSettleMatchesSequential(1);
+    testSettleMatchesSequential(3);
+    return testResult();
+}
@@ -0,0 +1,56 @@
+#include <cstdint>
+#include "simulation.h"
+#include "test_check.h"
+using namespace std;
+
+struct RunResult {
+    uint64_t digest;
+    int accepted[MAX_STATIONS];
+    int redirected[MAX_STATIONS];
+    int completed[MAX_STATIONS];
+};
+
+static RunResult simulate(uint64_t seed, int threads) {
+    ChargingNetwork network;
+    DeterministicSimulator sim(network, seed);
+    sim.run(40, threads);
+    RunResult r;
+    r.digest = sim.digest();
+    for (int s = 0; s < MAX_STATIONS; s++) {
+        r.accepted[s] = sim.shards[s].accepted;
+        r.redirected[s] = sim.shards[s].redirected;
+        r.completed[s] = sim.shards[s].completed;
+    }
+    return r;
+}
+
+// Every thread count replays the same events and ends with the same bookings
+static void testDigestIndependentOfThreads() {
+    for (uint64_t seed = 1; seed <= 4; seed++) {
+        RunResult single = simulate(seed, 1);
+        int total = 0;
+        for (int s = 0; s < MAX_STATIONS; s++) total += single.accepted[s];
+        CHECK(total > 0);
+        for (int threads = 2; threads <= MAX_STATIONS + 2; threads++) {
+            RunResult parallel = simulate(seed, threads);
+            CHECK(parallel.digest == single.digest);
+            for (int s = 0; s < MAX_STATIONS; s++) {
+                CHECK(parallel.accepted[s] == single.accepted[s]);
+                CHECK(parallel.redirected[s] == single.redirected[s]);
+                CHECK(parallel.completed[s] == single.completed[s]);
+            }
+        }
+    }
+}
+
+// The digest does reflect the run: another seed gives another one
+static void testDigestFollowsSeed() {
+    CHECK(simulate(1, 1).digest != simulate(2, 1).digest);
+    CHECK(simulate(7, 3).digest == simulate(7, 3).digest);
+}
+
+int main() {
+    testDigestIndependentOfThreads();
+    testDigestFollowsSeed();
+    return testResult();
+}
@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <vector>
+#include "time_series_store.h"
+#include "test_check.h"
+using namespace std;
+
+// Irregular timestamps and values round-trip exactly, across chunk edges
+static void testRoundTrip() {
+    TimeSeriesStore store;
+    int s = store.seriesFor(1, 3);
+    CHECK(store.seriesFor(1, 3) == s);
+    CHECK(store.seriesFor(2, 3) != s);
+    vector<SeriesSample> written;
+    long long t = 1000;
+    for (int i = 0; i < 3 * TimeSeriesStore::CHUNK_SAMPLES + 17; i++) {
+        t += 10000 + (i % 7 == 0 ? 137 : 0) - (i % 11 == 0 ? 3000 : 0);
+        float v = (i % 100 < 50) ? 7.0f : 7.0f - 0.013f * (i % 13);
+        if (i % 997 == 0) v = -1.5e6f;
+        CHECK(store.append(s, t, v));
+        written.push_back(SeriesSample{ t, v });
+    }
+    CHECK(!store.append(s, t, 1.0f));
+    CHECK(store.sampleCount() == (long long)written.size());
+    CHECK(store.compressedBytes() < (long long)(written.size() * sizeof(SeriesSample)) / 4);
+
+    vector<SeriesSample> read;
+    store.read(s, 0, t + 1, read);
+    CHECK(read.size() == written.size());
+    bool same = read.size() == written.size();
+    for (size_t i = 0; same && i < read.size(); i++) {
+        same = read[i].timestampMs == written[i].timestampMs && read[i].value == written[i].value;
+    }
+    CHECK(same);
+
+    read.clear();
+    store.read(s, written[5].timestampMs, written[9].timestampMs, read);
+    CHECK(read.size() == 4 && read[0].timestampMs == written[5].timestampMs);
+}
+
+// Buckets aggregate the samples they cover, whether taken from chunk
+// summaries or decoded
+static void testScanBuckets() {
+    TimeSeriesStore store;
+    int s = store.seriesFor(1, 1);
+    for (long long t = 0; t < 10000000; t += 1000) store.append(s, t, (float)(t / 1000000));
+    vector<SeriesBucket> buckets;
+    CHECK(store.scan(s, 0, 10000000, 2500000, buckets) == 10000);
+    CHECK(buckets.size() == 4);
+    CHECK(buckets[0].count == 2500);
+    CHECK_NEAR(buckets[0].minValue, 0.0f, 1e-6);
+    CHECK_NEAR(buckets[0].maxValue, 2.0f, 1e-6);
+    CHECK_NEAR(buckets[3].sum, 500.0 * 7 + 1000.0 * 8 + 1000.0 * 9, 1e-3);
+    CHECK(store.scan(s, 20000000, 30000000, 1000000, buckets) == 0);
+    CHECK(buckets.size() == 10 && buckets[0].count == 0);
+}
+
+static void testSaveLoad() {
+    TimeSeriesStore store;
+    int s = store.seriesFor(4, 2);
+    for (int i = 0; i < 100; i++) store.append(s, i * 1000LL, 3.5f + i);
+    const char* path = "test_time_series_store.bin";
+    CHECK(store.save(path));
+    TimeSeriesStore loaded;
+    CHECK(loaded.load(path));
+    remove(path);
+    CHECK(loaded.seriesFor(4, 2) == s && loaded.sampleCount() == 100);
+    CHECK(loaded.append(s, 100000, 1.0f));
+    CHECK(!loaded.append(s, 500, 1.0f));
+    vector<SeriesSample> read;
+    loaded.read(s, 0, 200000, read);
+    CHECK(read.size() == 101 && read[99].value == 102.5f && read[100].timestampMs == 100000);
+}
+
+int main() {
+    testRoundTrip();
+    testScanBuckets();
+    testSaveLoad();
+    return testResult();
+}
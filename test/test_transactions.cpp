@@ -0,0 +1,66 @@
+#include "booking_transaction.h"
+#include "test_check.h"
+using namespace std;
+
+// Station under a 10 kW site; user 1 owns vehicles 10-12
+static void setUp(ChargingStation& st, PowerConstraintTree& tree) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    for (int v = 10; v <= 12; v++) st.registerVehicle(v, 1, 20.0f, 80.0f, false);
+    st.attachPowerTree(&tree, tree.addNode(-1, 10.0f));
+}
+
+static TransactionRequest slowRequest(int vehicleID, float windowStart, float windowEnd) {
+    TransactionRequest r = { 1, vehicleID, windowStart, windowEnd, 1.0f, SLOW, 1 };
+    return r;
+}
+
+static void testCommitPlacesAll() {
+    ChargingStation st(1);
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    for (int v = 10; v <= 12; v++) st.registerVehicle(v, 1, 20.0f, 80.0f, false);
+    BookingTransaction tx;
+    for (int v = 10; v <= 12; v++) CHECK(tx.stage(st, slowRequest(v, 1.0f, 2.0f)));
+    CHECK(tx.commit());
+    CHECK(st.bookingCount == 3);
+    for (int k = 0; k < tx.size(); k++) CHECK(tx.booking(k).bookingID != -1);
+}
+
+// Staging counts the transaction's own bookings against the site's headroom
+static void testStagedLoadCounted() {
+    PowerConstraintTree tree;
+    ChargingStation st(1);
+    setUp(st, tree);
+    BookingTransaction tx;
+    CHECK(tx.stage(st, slowRequest(10, 1.0f, 2.0f)));
+    CHECK(!tx.stage(st, slowRequest(11, 1.0f, 2.0f)));
+    CHECK(tx.stage(st, slowRequest(11, 1.0f, 3.0f)));
+    CHECK_NEAR(tx.booking(1).startTime, 2.0f, 1e-4);
+    CHECK_NEAR(st.powerHeadroom(0.0f, 24.0f), 10.0f, 1e-4); // staging leaves the tree untouched
+    CHECK(tx.commit());
+    CHECK(st.bookingCount == 2);
+    for (int i = 0; i < st.bookingCount; i++) CHECK_NEAR(st.bookings[i].gridKW, 7.0f, 1e-4);
+}
+
+// Headroom taken after staging aborts the commit before anything is placed
+static void testCommitRechecksHeadroom() {
+    PowerConstraintTree tree;
+    ChargingStation st(1);
+    setUp(st, tree);
+    BookingTransaction tx;
+    CHECK(tx.stage(st, slowRequest(10, 1.0f, 2.0f)));
+    CHECK(tx.stage(st, slowRequest(11, 4.0f, 5.0f)));
+    CHECK(st.placeBooking(1, 12, 1, 4.0f, 1.0f, 1) != -1);
+    CHECK(!tx.commit());
+    CHECK(tx.size() == 0);
+    CHECK(st.bookingCount == 1);
+    CHECK_NEAR(st.powerHeadroom(1.0f, 2.0f), 10.0f, 1e-4);
+}
+
+int main() {
+    testCommitPlacesAll();
+    testStagedLoadCounted();
+    testCommitRechecksHeadroom();
+    return testResult();
+}
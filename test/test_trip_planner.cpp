@@ -0,0 +1,95 @@
+#include "trip_planner.h"
+#include "test_check.h"
+using namespace std;
+
+// Network where user 1 owns vehicles 10 and 11, 60 kWh at 30%, everywhere
+static void setUp(ChargingNetwork& network) {
+    for (int s = 0; s < MAX_STATIONS; s++) {
+        ChargingStation& st = *network.stations[s];
+        st.setLog(&testLog);
+        st.registerUser(1, "Test", 0);
+        st.registerVehicle(10, 1, 30.0f, 60.0f, false);
+        st.registerVehicle(11, 1, 30.0f, 60.0f, false);
+    }
+}
+
+// Vehicle 10: the 50 km to station 1 leaves 13.3%, the 150 km after it needs 50% plus the reserve
+static TripRequest oneStopTrip() {
+    TripRequest r;
+    r.userID = 1;
+    r.vehicleID = 10;
+    r.departureTime = 1.0f;
+    r.consumptionKWhPerKm = 0.2f;
+    r.speedKmh = 100.0f;
+    r.reserveSOC = 10.0f;
+    r.route.push_back(TripStop{ 1, 50.0f });
+    r.finalDistanceKm = 150.0f;
+    return r;
+}
+
+static void testPlanChargesEnough() {
+    ChargingNetwork network;
+    setUp(network);
+    TripPlanner planner(network);
+    TripPlan plan;
+    TripRequest request = oneStopTrip();
+    CHECK(planner.plan(request, plan));
+    CHECK(plan.legs.size() == 1);
+    if (plan.legs.size() != 1) return;
+    CHECK(plan.legs[0].stationID == 1);
+    CHECK(plan.legs[0].departureSOC >= 60.0f);
+    CHECK(plan.arrivalSOC >= request.reserveSOC);
+    CHECK(planner.book(request, plan));
+    CHECK(plan.legs[0].bookingID != -1);
+    CHECK(network.stations[0]->bookingCount == 1);
+}
+
+// Only docks the site's headroom can supply are planned, and a leg whose
+// headroom is taken before booking is not placed
+static void testBookRechecksHeadroom() {
+    ChargingNetwork network;
+    setUp(network);
+    int root = network.powerTree.addNode(-1, 100.0f);
+    network.addSite(1, root, 10.0f);
+    TripPlanner planner(network);
+    TripPlan plan;
+    TripRequest request = oneStopTrip();
+    CHECK(planner.plan(request, plan));
+    CHECK(plan.legs.size() == 1);
+    if (plan.legs.size() != 1) return;
+    const TripLeg& leg = plan.legs[0];
+    CHECK(ChargingStation::powerRatingFor(leg.chargingType) <= 10);
+
+    ChargingStation& st = *network.stations[0];
+    int other = (leg.dockSlot == 0) ? 1 : 0;
+    CHECK(st.placeBooking(1, 11, other, leg.startTime, leg.duration, 1) != -1);
+    CHECK(!planner.book(request, plan));
+    CHECK(st.bookingCount == 1);
+}
+
+// Capacity and SOC come from the registered vehicle, and unknown vehicles
+// are rejected
+static void testVehicleFromRecord() {
+    ChargingNetwork network;
+    setUp(network);
+    TripPlanner planner(network);
+    TripPlan plan;
+    TripRequest request = oneStopTrip();
+    network.stations[0]->vehicles[0].batterySOC = 90.0f;
+    CHECK(planner.plan(request, plan));
+    CHECK(plan.legs.empty());
+    CHECK_NEAR(plan.arrivalSOC, 90.0f - 200.0f * 0.2f / 60.0f * 100.0f, 1e-3);
+
+    request.vehicleID = 99;
+    CHECK(!planner.plan(request, plan));
+    request.vehicleID = 10;
+    request.userID = 2;
+    CHECK(!planner.plan(request, plan));
+}
+
+int main() {
+    testPlanChargesEnough();
+    testBookRechecksHeadroom();
+    testVehicleFromRecord();
+    return testResult();
+}
@@ -0,0 +1,62 @@
+#include "charging_station.h"
+#include "test_check.h"
+using namespace std;
+
+// User 1 owns vehicle 10, limited to 7 kW on AC and DC, and vehicle 11 with
+// the default limits. Sessions at 20:00-22:00 on docks 1-4 leave the FAST
+// dock (5) the least loaded.
+static void setUp(ChargingStation& st) {
+    st.setLog(&testLog);
+    st.registerUser(1, "Test", 0);
+    st.registerVehicle(10, 1, 20.0f, 60.0f, false);
+    st.registerVehicle(11, 1, 20.0f, 60.0f, false);
+    st.vehicles[st.findVehicleIndex(10, 1)].setChargingLimits(SLOW, SLOW, ALL_CONNECTORS);
+    for (int slot = 0; slot < 4; slot++) CHECK(st.placeBooking(1, 11, slot, 20.0f, 2.0f, 1) != -1);
+    st.setDockPolicy(POLICY_LEAST_LOADED);
+}
+
+// The limited vehicle is given a SLOW dock; an unlimited one takes the FAST dock
+static void testKeptOffFastDock() {
+    ChargingStation st;
+    setUp(st);
+    CHECK(st.createBooking(1, 10, 1.0f, 2.0f, SLOW, 1));
+    const Booking& limited = st.bookings[st.bookingCount - 1];
+    CHECK(st.docks[limited.dockSlot].powerRating == SLOW);
+
+    CHECK(st.createBooking(1, 11, 1.0f, 2.0f, SLOW, 1));
+    CHECK(st.bookings[st.bookingCount - 1].dockID == 5);
+}
+
+// Once the SLOW docks are taken it falls back to a larger one, and is billed
+// at the power it accepts
+static void testBillingCapped() {
+    ChargingStation st;
+    setUp(st);
+    for (int slot = 0; slot < 4; slot++) CHECK(st.placeBooking(1, 11, slot, 1.0f, 2.0f, 1) != -1);
+    CHECK(st.createBooking(1, 10, 1.0f, 2.0f, SLOW, 1));
+    const Booking& b = st.bookings[st.bookingCount - 1];
+    CHECK(b.dockID == 5);
+    CHECK_NEAR(st.effectivePower(b.dockSlot, st.findVehicleIndex(10, 1)), (float)SLOW, 1e-6);
+
+    int vehicle = st.findVehicleIndex(10, 1);
+    st.completeBooking(b.bookingID);
+    CHECK(b.energyWh == SLOW * 2 * 1000);
+    CHECK_NEAR(st.vehicles[vehicle].batterySOC, 20.0f + SLOW * 2.0f / 60.0f * 100.0f, 1e-3);
+}
+
+// A vehicle without a DC inlet is never given the FAST dock
+static void testNoDcInlet() {
+    ChargingStation st;
+    setUp(st);
+    st.vehicles[st.findVehicleIndex(10, 1)].setChargingLimits(SLOW, 0.0f, CONNECTOR_TYPE2);
+    for (int slot = 0; slot < 4; slot++) CHECK(st.placeBooking(1, 11, slot, 1.0f, 2.0f, 1) != -1);
+    CHECK(!st.createBooking(1, 10, 1.0f, 2.0f, SLOW, 1));
+    CHECK(st.schedules[4].empty());
+}
+
+int main() {
+    testKeptOffFastDock();
+    testBillingCapped();
+    testNoDcInlet();
+    return testResult();
+}